@@ -0,0 +1,177 @@
+/* Copyright 2024 Jack A Bernard Jr.
+ *
+ * Licensed under the Apache License, Version 2.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SUMTY_ATOMIC_OPTION_HPP
+#define SUMTY_ATOMIC_OPTION_HPP
+
+#include "sumty/detail/atomic.hpp"
+#include "sumty/option.hpp"
+#include "sumty/utils.hpp"
+#include "sumty/variant.hpp"
+
+#include <atomic>
+#include <type_traits>
+
+namespace sumty {
+
+/// @class atomic_option atomic_option.hpp <sumty/atomic_option.hpp>
+/// @brief Atomic @ref option
+///
+/// @details
+/// @ref atomic_option provides atomic access to an @ref option, with an
+/// interface modeled after `std::atomic`. `T` must be trivially copyable, or
+/// an lvalue reference.
+///
+/// The @ref option is stored in a packed form, where the payload is
+/// followed by a one byte flag, and unused bytes are always zero. An
+/// `atomic_option<T&>` is packed as a single pointer. When the packed form
+/// fits in 8 bytes (or 16 bytes on targets with a double-width CAS, such as
+/// x86-64 with `-mcx16`), every operation is lock-free. Otherwise,
+/// @ref atomic_option falls back to a sequence lock, where @ref load does not
+/// write to shared memory and writers are serialized.
+///
+/// @ref compare_exchange compares the packed forms bitwise, so two
+/// @ref option values compare equal when both are empty, or when both
+/// contain values with identical object representations.
+///
+/// ## Example
+/// ```cpp
+/// struct config {
+///     int threads;
+///     int timeout_ms;
+/// };
+///
+/// atomic_option<config> current{};
+///
+/// // writer
+/// current.store(config{4, 100});
+/// current.notify_all();
+///
+/// // readers
+/// current.wait(none);
+/// option<config> snapshot = current.load();
+/// ```
+///
+/// @tparam T The value type of the contained @ref option
+template <typename T>
+class atomic_option {
+  private:
+    static_assert(detail::is_bitwise_copyable<T>::value,
+                  "atomic_option requires a trivially copyable value type");
+
+    using codec_t = detail::variant_codec<variant<void, T>>;
+    using storage_t = detail::packed_atomic_storage_t<codec_t::size>;
+
+    static constexpr std::memory_order failure_order(std::memory_order order) noexcept {
+        switch (order) {
+            case std::memory_order_acq_rel: return std::memory_order_acquire;
+            case std::memory_order_release: return std::memory_order_relaxed;
+            default: return order;
+        }
+    }
+
+    [[nodiscard]] static typename codec_t::bytes pack(const option<T>& opt) noexcept {
+        if (opt.has_value()) {
+            return codec_t::pack(variant<void, T>(std::in_place_index<1>, *opt));
+        }
+        return codec_t::pack(variant<void, T>{});
+    }
+
+    [[nodiscard]] static option<T> unpack(const typename codec_t::bytes& bytes) noexcept {
+        if (codec_t::index_of(bytes) == 0) { return none; }
+        return option<T>(std::in_place, codec_t::unpack(bytes)[index<1>]);
+    }
+
+    storage_t storage_;
+
+  public:
+    using value_type = option<T>;
+
+    /// @brief `true` if every operation is always lock-free
+    static constexpr bool is_always_lock_free = storage_t::is_always_lock_free;
+
+    /// @brief Constructs an empty @ref atomic_option
+    atomic_option() noexcept : storage_(pack(none)) {}
+
+    /// @brief Constructs an @ref atomic_option with an initial value
+    // NOLINTNEXTLINE(hicpp-explicit-conversions)
+    atomic_option(const option<T>& init) noexcept : storage_(pack(init)) {}
+
+    atomic_option(const atomic_option&) = delete;
+
+    atomic_option& operator=(const atomic_option&) = delete;
+
+    ~atomic_option() noexcept = default;
+
+    [[nodiscard]] bool is_lock_free() const noexcept { return is_always_lock_free; }
+
+    [[nodiscard]] option<T> load(
+        std::memory_order order = std::memory_order_seq_cst) const noexcept {
+        return unpack(storage_.load(order));
+    }
+
+    void store(const option<T>& desired,
+               std::memory_order order = std::memory_order_seq_cst) noexcept {
+        storage_.store(pack(desired), order);
+    }
+
+    /// @brief Atomically replaces the value and returns the previous value
+    option<T> exchange(const option<T>& desired,
+                       std::memory_order order = std::memory_order_seq_cst) noexcept {
+        return unpack(storage_.exchange(pack(desired), order));
+    }
+
+    /// @brief Atomically replaces the value with `desired` if it is equal to
+    /// `expected`.
+    ///
+    /// @details
+    /// If the value is not equal to `expected`, `expected` is updated to the
+    /// current value and `false` is returned.
+    bool compare_exchange(option<T>& expected,
+                          const option<T>& desired,
+                          std::memory_order order = std::memory_order_seq_cst) noexcept {
+        auto exp = pack(expected);
+        if (storage_.compare_exchange(exp, pack(desired), order, failure_order(order))) {
+            return true;
+        }
+        expected = unpack(exp);
+        return false;
+    }
+
+    /// @brief Atomically takes the value, leaving the @ref atomic_option
+    /// empty.
+    option<T> take(std::memory_order order = std::memory_order_seq_cst) noexcept {
+        return exchange(none, order);
+    }
+
+    /// @brief Blocks until the value is no longer equal to `old`
+    ///
+    /// @details
+    /// Like `std::atomic::wait`, this function is only guaranteed to return
+    /// after the value has been changed and @ref notify_one or
+    /// @ref notify_all has been called.
+    void wait(const option<T>& old,
+              std::memory_order order = std::memory_order_seq_cst) const noexcept {
+        storage_.wait(pack(old), order);
+    }
+
+    void notify_one() noexcept { storage_.notify_one(); }
+
+    void notify_all() noexcept { storage_.notify_all(); }
+};
+
+} // namespace sumty
+
+#endif
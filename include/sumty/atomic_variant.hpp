@@ -0,0 +1,189 @@
+/* Copyright 2024 Jack A Bernard Jr.
+ *
+ * Licensed under the Apache License, Version 2.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SUMTY_ATOMIC_VARIANT_HPP
+#define SUMTY_ATOMIC_VARIANT_HPP
+
+#include "sumty/detail/atomic.hpp"
+#include "sumty/variant.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+namespace sumty {
+
+/// @class atomic_variant atomic_variant.hpp <sumty/atomic_variant.hpp>
+/// @brief Atomic @ref variant
+///
+/// @details
+/// @ref atomic_variant provides atomic access to a @ref variant, with an
+/// interface modeled after `std::atomic`. Every alternative must be
+/// trivially copyable, `void`, or an lvalue reference.
+///
+/// The @ref variant is stored in a packed form, where the largest payload is
+/// followed by a one byte discriminant, and unused bytes are always zero.
+/// When the packed form fits in 8 bytes (or 16 bytes on targets with a
+/// double-width CAS, such as x86-64 with `-mcx16`), every operation is
+/// lock-free, and @ref is_always_lock_free is `true`. Otherwise,
+/// @ref atomic_variant falls back to a sequence lock. For large, read-mostly
+/// state, @ref seqlock_variant offers the same snapshots with a richer write
+/// interface.
+///
+/// @ref compare_exchange compares both the alternative index and the
+/// object representation of the payload, so it succeeds only if the
+/// @ref atomic_variant holds the same alternative as `expected`, with a
+/// bitwise identical value.
+///
+/// ## Example
+/// ```cpp
+/// struct idle {};
+/// struct connecting { uint32_t attempt; };
+/// struct closed {};
+///
+/// atomic_variant<idle, connecting, closed> state{};
+///
+/// variant<idle, connecting, closed> expected{};
+/// if (state.compare_exchange(expected, connecting{1})) {
+///     // this thread owns the connection attempt
+/// }
+///
+/// state.visit(overload(
+///     [](idle) { /* ... */ },
+///     [](connecting c) { /* ... */ },
+///     [](closed) { /* ... */ }
+/// ));
+/// ```
+///
+/// @tparam T The alternative types of the contained @ref variant
+template <typename... T>
+class atomic_variant {
+  private:
+    static_assert((detail::is_bitwise_copyable<T>::value && ...),
+                  "atomic_variant requires trivially copyable alternatives");
+
+    using codec_t = detail::variant_codec<variant<T...>>;
+    using storage_t = detail::packed_atomic_storage_t<codec_t::size>;
+
+    static constexpr std::memory_order failure_order(std::memory_order order) noexcept {
+        switch (order) {
+            case std::memory_order_acq_rel: return std::memory_order_acquire;
+            case std::memory_order_release: return std::memory_order_relaxed;
+            default: return order;
+        }
+    }
+
+    storage_t storage_;
+
+  public:
+    using value_type = variant<T...>;
+
+    /// @brief `true` if every operation is always lock-free
+    static constexpr bool is_always_lock_free = storage_t::is_always_lock_free;
+
+    /// @brief Constructs an @ref atomic_variant holding a default constructed
+    /// first alternative
+    atomic_variant() noexcept : storage_(codec_t::pack(variant<T...>{})) {}
+
+    /// @brief Constructs an @ref atomic_variant with an initial value
+    // NOLINTNEXTLINE(hicpp-explicit-conversions)
+    atomic_variant(const variant<T...>& init) noexcept : storage_(codec_t::pack(init)) {}
+
+    /// @brief Constructs an @ref atomic_variant holding the alternative at
+    /// index `IDX`, constructed in place
+    template <size_t IDX, typename... Args>
+    explicit atomic_variant(std::in_place_index_t<IDX> inplace, Args&&... args)
+        : storage_(codec_t::pack(variant<T...>(inplace, std::forward<Args>(args)...))) {}
+
+    atomic_variant(const atomic_variant&) = delete;
+
+    atomic_variant& operator=(const atomic_variant&) = delete;
+
+    ~atomic_variant() noexcept = default;
+
+    [[nodiscard]] bool is_lock_free() const noexcept { return is_always_lock_free; }
+
+    [[nodiscard]] variant<T...> load(
+        std::memory_order order = std::memory_order_seq_cst) const noexcept {
+        return codec_t::unpack(storage_.load(order));
+    }
+
+    /// @brief Atomically loads the index of the current alternative
+    [[nodiscard]] size_t index(
+        std::memory_order order = std::memory_order_seq_cst) const noexcept {
+        return codec_t::index_of(storage_.load(order));
+    }
+
+    void store(const variant<T...>& desired,
+               std::memory_order order = std::memory_order_seq_cst) noexcept {
+        storage_.store(codec_t::pack(desired), order);
+    }
+
+    /// @brief Atomically replaces the value and returns the previous value
+    variant<T...> exchange(const variant<T...>& desired,
+                           std::memory_order order = std::memory_order_seq_cst) noexcept {
+        return codec_t::unpack(storage_.exchange(codec_t::pack(desired), order));
+    }
+
+    /// @brief Atomically replaces the value with `desired` if it holds the
+    /// same alternative as `expected` with the same value.
+    ///
+    /// @details
+    /// If the value is not equal to `expected`, `expected` is updated to the
+    /// current value and `false` is returned.
+    bool compare_exchange(variant<T...>& expected,
+                          const variant<T...>& desired,
+                          std::memory_order order = std::memory_order_seq_cst) noexcept {
+        auto exp = codec_t::pack(expected);
+        if (storage_.compare_exchange(exp, codec_t::pack(desired), order,
+                                      failure_order(order))) {
+            return true;
+        }
+        expected = codec_t::unpack(exp);
+        return false;
+    }
+
+    /// @brief Calls a visitor with the alternative of an atomically loaded
+    /// snapshot
+    ///
+    /// @details
+    /// The visitor is called as if by `load(order).visit(visitor)`. Because
+    /// the snapshot does not outlive the call, the result of the visitor is
+    /// returned by value.
+    template <typename V>
+    auto visit(V&& visitor, std::memory_order order = std::memory_order_seq_cst) const {
+        const auto snapshot = load(order);
+        return snapshot.visit(std::forward<V>(visitor));
+    }
+
+    /// @brief Blocks until the value is no longer equal to `old`
+    ///
+    /// @details
+    /// Like `std::atomic::wait`, this function is only guaranteed to return
+    /// after the value has been changed and @ref notify_one or
+    /// @ref notify_all has been called.
+    void wait(const variant<T...>& old,
+              std::memory_order order = std::memory_order_seq_cst) const noexcept {
+        storage_.wait(codec_t::pack(old), order);
+    }
+
+    void notify_one() noexcept { storage_.notify_one(); }
+
+    void notify_all() noexcept { storage_.notify_all(); }
+};
+
+} // namespace sumty
+
+#endif
@@ -0,0 +1,221 @@
+/* Copyright 2024 Jack A Bernard Jr.
+ *
+ * Licensed under the Apache License, Version 2.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SUMTY_COMPACT_ERROR_HPP
+#define SUMTY_COMPACT_ERROR_HPP
+
+#include "sumty/option.hpp"
+#include "sumty/result.hpp"
+#include "sumty/utils.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <ios>
+#include <string>
+#include <system_error>
+#include <type_traits>
+
+namespace sumty {
+
+namespace detail {
+
+class compact_error_registry {
+  private:
+    std::array<std::atomic<const std::error_category*>, 256> cats_{};
+
+    compact_error_registry() noexcept {
+        cats_[0].store(&std::system_category(), std::memory_order_relaxed);
+        cats_[1].store(&std::generic_category(), std::memory_order_relaxed);
+        cats_[2].store(&std::iostream_category(), std::memory_order_relaxed);
+        cats_[3].store(&std::future_category(), std::memory_order_relaxed);
+    }
+
+  public:
+    [[nodiscard]] static compact_error_registry& get() noexcept {
+        static compact_error_registry registry{};
+        return registry;
+    }
+
+    [[nodiscard]] const std::error_category& at(uint32_t idx) const noexcept {
+        return *cats_[idx].load(std::memory_order_acquire);
+    }
+
+    [[nodiscard]] option<uint32_t> index_of(const std::error_category& cat) noexcept {
+        for (uint32_t i = 0; i < cats_.size(); ++i) {
+            const auto* entry = cats_[i].load(std::memory_order_acquire);
+            if (entry == nullptr) {
+                // registration is append-only, so this is the first free slot
+                if (cats_[i].compare_exchange_strong(entry, &cat, std::memory_order_acq_rel,
+                                                     std::memory_order_acquire)) {
+                    return i;
+                }
+            }
+            if (entry == &cat) { return i; }
+        }
+        return none;
+    }
+};
+
+} // namespace detail
+
+/// @class compact_error compact_error.hpp <sumty/compact_error.hpp>
+/// @brief 32-bit error code that converts to and from `std::error_code`
+///
+/// @details
+/// `std::error_code` consists of an `int` and a pointer to a category, which
+/// makes it 16 bytes on 64-bit platforms, and makes `result<int>` 24 bytes.
+/// @ref compact_error packs the error category into an 8-bit index into a
+/// global category table, and the error value into the remaining 24 bits.
+/// As a result, `result<int, compact_error>` (see @ref result_c) is 8 bytes
+/// and is trivially copyable, so it is returned in a single register.
+///
+/// The system, generic, iostream, and future categories are registered
+/// up front. Other categories are registered the first time an error of that
+/// category is converted to a @ref compact_error. At most 256 categories can
+/// be registered.
+///
+/// Error values must be representable as a 24-bit signed integer. An error
+/// that cannot be represented, either because its value is out of range or
+/// because the category table is full, is converted to
+/// `std::errc::value_too_large`. Use @ref try_from to detect such lossy
+/// conversions instead.
+///
+/// ## Example
+/// ```cpp
+/// result_c<int> parse_digit(char c) {
+///     if (c < '0' || c > '9') {
+///         return error<compact_error>(std::errc::invalid_argument);
+///     }
+///     return c - '0';
+/// }
+///
+/// static_assert(sizeof(result_c<int>) == 8);
+///
+/// std::error_code ec = parse_digit('x').error();
+/// assert(ec == std::errc::invalid_argument);
+/// ```
+class compact_error {
+  private:
+    static constexpr uint32_t CODE_BITS = 24;
+    static constexpr uint32_t CODE_MASK = (uint32_t{1} << CODE_BITS) - 1;
+
+    uint32_t bits_{0};
+
+    static constexpr compact_error value_too_large() noexcept {
+        return from_bits((uint32_t{1} << CODE_BITS) |
+                         static_cast<uint32_t>(std::errc::value_too_large));
+    }
+
+  public:
+    /// @brief Smallest error value that can be represented
+    static constexpr int min_value = -(1 << (CODE_BITS - 1));
+
+    /// @brief Largest error value that can be represented
+    static constexpr int max_value = (1 << (CODE_BITS - 1)) - 1;
+
+    /// @brief Constructs a @ref compact_error with value zero in the system
+    /// category, which represents success like a default constructed
+    /// `std::error_code`.
+    constexpr compact_error() noexcept = default;
+
+    /// @brief Converts a `std::error_code` into a @ref compact_error
+    ///
+    /// @details
+    /// If the error cannot be represented, the @ref compact_error contains
+    /// `std::errc::value_too_large` instead.
+    // NOLINTNEXTLINE(hicpp-explicit-conversions)
+    compact_error(std::error_code ec) noexcept
+        : compact_error(try_from(ec).value_or(value_too_large())) {}
+
+    compact_error(int value, const std::error_category& cat) noexcept
+        : compact_error(std::error_code(value, cat)) {}
+
+    // NOLINTNEXTLINE(hicpp-explicit-conversions)
+    compact_error(std::errc err) noexcept : compact_error(std::make_error_code(err)) {}
+
+    template <typename E>
+#ifndef DOXYGEN
+        requires(std::is_error_code_enum_v<E>)
+#endif
+    // NOLINTNEXTLINE(hicpp-explicit-conversions)
+    compact_error(E err) noexcept : compact_error(std::error_code(err)) {
+    }
+
+    /// @brief Converts a `std::error_code` into a @ref compact_error, if it
+    /// can be represented.
+    [[nodiscard]] static option<compact_error> try_from(std::error_code ec) noexcept {
+        if (ec.value() < min_value || ec.value() > max_value) { return none; }
+        return detail::compact_error_registry::get().index_of(ec.category()).transform(
+            [&ec](uint32_t idx) {
+                return from_bits((idx << CODE_BITS) |
+                                 (static_cast<uint32_t>(ec.value()) & CODE_MASK));
+            });
+    }
+
+    /// @brief Reconstructs a @ref compact_error from its packed representation
+    [[nodiscard]] static constexpr compact_error from_bits(uint32_t bits) noexcept {
+        compact_error ret;
+        ret.bits_ = bits;
+        return ret;
+    }
+
+    /// @brief Gets the packed representation of the error
+    [[nodiscard]] constexpr uint32_t bits() const noexcept { return bits_; }
+
+    /// @brief Gets the error value
+    [[nodiscard]] constexpr int value() const noexcept {
+        // shift the code into the high bits so it is sign extended on the way back
+        return static_cast<int32_t>(bits_ << (32 - CODE_BITS)) >> (32 - CODE_BITS);
+    }
+
+    /// @brief Gets the error category
+    [[nodiscard]] const std::error_category& category() const noexcept {
+        return detail::compact_error_registry::get().at(bits_ >> CODE_BITS);
+    }
+
+    [[nodiscard]] std::string message() const { return category().message(value()); }
+
+    [[nodiscard]] std::error_code to_error_code() const noexcept {
+        return std::error_code(value(), category());
+    }
+
+    // NOLINTNEXTLINE(hicpp-explicit-conversions)
+    operator std::error_code() const noexcept { return to_error_code(); }
+
+    /// @brief Checks if the error value is non-zero
+    constexpr explicit operator bool() const noexcept { return (bits_ & CODE_MASK) != 0; }
+
+    /// @brief Resets the error to value zero in the system category
+    constexpr void clear() noexcept { bits_ = 0; }
+
+    friend constexpr bool operator==(compact_error lhs, compact_error rhs) noexcept {
+        return lhs.bits_ == rhs.bits_;
+    }
+};
+
+/// @brief Alias of @ref result that uses @ref compact_error as the error type
+///
+/// @details
+/// `result_c<T>` is the same size as `result<T, uint32_t>`, so for small
+/// value types such as `int` it fits in a single register.
+template <typename T>
+using result_c = result<T, compact_error>;
+
+} // namespace sumty
+
+#endif
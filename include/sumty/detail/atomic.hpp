@@ -0,0 +1,443 @@
+/* Copyright 2024 Jack A Bernard Jr.
+ *
+ * Licensed under the Apache License, Version 2.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SUMTY_DETAIL_ATOMIC_HPP
+#define SUMTY_DETAIL_ATOMIC_HPP
+
+#include "sumty/detail/fwd.hpp"
+#include "sumty/detail/utils.hpp"
+#include "sumty/variant.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+namespace sumty::detail {
+
+// Empty types have no value bits, so they are packed as zero bytes. Copying
+// their (indeterminate) byte would make otherwise equal values compare
+// unequal.
+template <typename T>
+struct atomic_payload_size
+    : std::integral_constant<size_t, std::is_empty_v<T> ? size_t{0} : sizeof(T)> {};
+
+template <typename T>
+struct atomic_payload_size<T&> : std::integral_constant<size_t, sizeof(T*)> {};
+
+template <>
+struct atomic_payload_size<void> : std::integral_constant<size_t, 0> {};
+
+template <typename T>
+struct is_bitwise_copyable : std::is_trivially_copyable<T> {};
+
+template <typename T>
+struct is_bitwise_copyable<T&> : std::true_type {};
+
+template <>
+struct is_bitwise_copyable<void> : std::true_type {};
+
+template <typename V>
+struct variant_codec;
+
+// Packs a variant into a zero-padded byte array, with the payload at offset
+// zero followed by a one byte discriminant. Because padding is always zero,
+// two packed variants are bitwise equal exactly when the discriminants are
+// equal and the payloads are bitwise equal, which is what makes the packed
+// form suitable for compare-and-swap. A variant of `void` and a single
+// lvalue reference is packed as just a pointer, with null meaning `void`.
+template <typename... T>
+struct variant_codec<variant<T...>> {
+    static_assert(sizeof...(T) <= 256, "too many alternatives to pack");
+
+    static constexpr bool null_niche =
+        sizeof...(T) == 2 &&
+        ((std::is_void_v<select_t<0, T...>> &&
+          std::is_lvalue_reference_v<select_t<1, T...>>) ||
+         (std::is_lvalue_reference_v<select_t<0, T...>> &&
+          std::is_void_v<select_t<1, T...>>));
+
+    static constexpr size_t payload_size = std::max({atomic_payload_size<T>::value...});
+
+    static constexpr size_t packed_size = null_niche ? sizeof(void*) : payload_size + 1;
+
+    static constexpr size_t size = packed_size <= 8    ? 8
+                                   : packed_size <= 16 ? 16
+                                                       : (packed_size + 7) / 8 * 8;
+
+    using bytes = std::array<std::byte, size>;
+
+  private:
+    template <size_t I>
+    static void pack_alt(bytes& out, const variant<T...>& var) noexcept {
+        using alt_t = select_t<I, T...>;
+        if constexpr (std::is_lvalue_reference_v<alt_t>) {
+            const auto* ptr = &var[index<I>];
+            std::memcpy(out.data(), static_cast<const void*>(&ptr), sizeof(ptr));
+        } else if constexpr (atomic_payload_size<alt_t>::value != 0) {
+            std::memcpy(out.data(), static_cast<const void*>(&var[index<I>]),
+                        sizeof(alt_t));
+        }
+        if constexpr (!null_niche) { out[payload_size] = static_cast<std::byte>(I); }
+    }
+
+    template <size_t I>
+    static variant<T...> unpack_alt(const bytes& in) noexcept {
+        using alt_t = select_t<I, T...>;
+        if constexpr (std::is_void_v<alt_t>) {
+            return variant<T...>(std::in_place_index<I>);
+        } else if constexpr (std::is_empty_v<alt_t>) {
+            return variant<T...>(std::in_place_index<I>, alt_t{});
+        } else if constexpr (std::is_lvalue_reference_v<alt_t>) {
+            std::remove_reference_t<alt_t>* ptr = nullptr;
+            std::memcpy(static_cast<void*>(&ptr), in.data(), sizeof(ptr));
+            return variant<T...>(std::in_place_index<I>, *ptr);
+        } else {
+            std::array<std::byte, sizeof(alt_t)> buf{};
+            std::memcpy(buf.data(), in.data(), sizeof(alt_t));
+            return variant<T...>(std::in_place_index<I>, std::bit_cast<alt_t>(buf));
+        }
+    }
+
+    template <size_t... I>
+    static bytes pack_impl(const variant<T...>& var,
+                           [[maybe_unused]] std::index_sequence<I...> seq) noexcept {
+        bytes out{};
+        static_cast<void>(((var.index() == I && (pack_alt<I>(out, var), true)) || ...));
+        return out;
+    }
+
+    template <size_t... I>
+    static variant<T...> unpack_impl(
+        const bytes& in,
+        [[maybe_unused]] std::index_sequence<I...> seq) noexcept {
+        static constexpr std::array<variant<T...> (*)(const bytes&), sizeof...(T)> table{
+            &unpack_alt<I>...};
+        return table[index_of(in)](in);
+    }
+
+  public:
+    [[nodiscard]] static bytes pack(const variant<T...>& var) noexcept {
+        return pack_impl(var, std::index_sequence_for<T...>{});
+    }
+
+    [[nodiscard]] static variant<T...> unpack(const bytes& in) noexcept {
+        return unpack_impl(in, std::index_sequence_for<T...>{});
+    }
+
+    [[nodiscard]] static size_t index_of(const bytes& in) noexcept {
+        if constexpr (null_niche) {
+            constexpr size_t ref_idx =
+                std::is_lvalue_reference_v<select_t<0, T...>> ? size_t{0} : size_t{1};
+            void* ptr = nullptr;
+            std::memcpy(static_cast<void*>(&ptr), in.data(), sizeof(ptr));
+            return ptr == nullptr ? 1 - ref_idx : ref_idx;
+        } else {
+            return static_cast<size_t>(in[payload_size]);
+        }
+    }
+};
+
+inline void atomic_spin_pause() noexcept { std::this_thread::yield(); }
+
+// Lock-free storage for 8 byte packed representations.
+class packed_atomic8 {
+  public:
+    using bytes = std::array<std::byte, 8>;
+
+    static constexpr bool is_always_lock_free = std::atomic<uint64_t>::is_always_lock_free;
+
+  private:
+    std::atomic<uint64_t> word_;
+
+  public:
+    explicit packed_atomic8(const bytes& init) noexcept
+        : word_(std::bit_cast<uint64_t>(init)) {}
+
+    [[nodiscard]] bytes load(std::memory_order order) const noexcept {
+        return std::bit_cast<bytes>(word_.load(order));
+    }
+
+    void store(const bytes& desired, std::memory_order order) noexcept {
+        word_.store(std::bit_cast<uint64_t>(desired), order);
+    }
+
+    [[nodiscard]] bytes exchange(const bytes& desired, std::memory_order order) noexcept {
+        return std::bit_cast<bytes>(
+            word_.exchange(std::bit_cast<uint64_t>(desired), order));
+    }
+
+    bool compare_exchange(bytes& expected,
+                          const bytes& desired,
+                          std::memory_order success,
+                          std::memory_order failure) noexcept {
+        auto exp = std::bit_cast<uint64_t>(expected);
+        const bool ret = word_.compare_exchange_strong(
+            exp, std::bit_cast<uint64_t>(desired), success, failure);
+        expected = std::bit_cast<bytes>(exp);
+        return ret;
+    }
+
+    void wait(const bytes& old, std::memory_order order) const noexcept {
+        word_.wait(std::bit_cast<uint64_t>(old), order);
+    }
+
+    void notify_one() noexcept { word_.notify_one(); }
+
+    void notify_all() noexcept { word_.notify_all(); }
+};
+
+#if defined(__GCC_HAVE_SYNC_COMPARE_AND_SWAP_16)
+#define SUMTY_HAS_PACKED_ATOMIC16 1
+
+// Lock-free storage for 16 byte packed representations, using cmpxchg16b (or
+// the equivalent double-width CAS) through the legacy __sync builtins, which
+// are expanded inline when the target supports them. std::atomic is not used
+// because 16 byte atomics are routed through libatomic.
+class packed_atomic16 {
+  public:
+    using bytes = std::array<std::byte, 16>;
+
+    static constexpr bool is_always_lock_free = true;
+
+  private:
+    __extension__ using word_t = unsigned __int128;
+
+    alignas(16) mutable word_t word_;
+    std::atomic<uint32_t> epoch_{0};
+
+    [[nodiscard]] word_t cas(word_t expected, word_t desired) const noexcept {
+        return __sync_val_compare_and_swap(&word_, expected, desired);
+    }
+
+    void bump() noexcept { epoch_.fetch_add(1, std::memory_order_release); }
+
+  public:
+    explicit packed_atomic16(const bytes& init) noexcept
+        : word_(std::bit_cast<word_t>(init)) {}
+
+    [[nodiscard]] bytes load([[maybe_unused]] std::memory_order order) const noexcept {
+        return std::bit_cast<bytes>(cas(0, 0));
+    }
+
+    void store(const bytes& desired, std::memory_order order) noexcept {
+        static_cast<void>(exchange(desired, order));
+    }
+
+    [[nodiscard]] bytes exchange(const bytes& desired,
+                                 [[maybe_unused]] std::memory_order order) noexcept {
+        const auto des = std::bit_cast<word_t>(desired);
+        auto cur = cas(0, 0);
+        for (;;) {
+            const auto prev = cas(cur, des);
+            if (prev == cur) { break; }
+            cur = prev;
+        }
+        bump();
+        return std::bit_cast<bytes>(cur);
+    }
+
+    bool compare_exchange(bytes& expected,
+                          const bytes& desired,
+                          [[maybe_unused]] std::memory_order success,
+                          [[maybe_unused]] std::memory_order failure) noexcept {
+        const auto exp = std::bit_cast<word_t>(expected);
+        const auto prev = cas(exp, std::bit_cast<word_t>(desired));
+        if (prev == exp) {
+            bump();
+            return true;
+        }
+        expected = std::bit_cast<bytes>(prev);
+        return false;
+    }
+
+    void wait(const bytes& old, std::memory_order order) const noexcept {
+        for (;;) {
+            const auto epoch = epoch_.load(std::memory_order_acquire);
+            if (load(order) != old) { return; }
+            epoch_.wait(epoch, std::memory_order_acquire);
+        }
+    }
+
+    void notify_one() noexcept { epoch_.notify_one(); }
+
+    void notify_all() noexcept { epoch_.notify_all(); }
+};
+#endif
+
+// Sequence lock storage for packed representations of any size. Readers
+// never write to shared memory, and retry if they observe a concurrent
+// write. The payload is kept in relaxed atomic words so that torn reads are
+// well defined and simply discarded.
+template <size_t N>
+class seqlock_storage {
+  public:
+    using bytes = std::array<std::byte, N>;
+
+    static constexpr bool is_always_lock_free = false;
+
+  private:
+    static_assert(N % sizeof(uint64_t) == 0);
+
+    static constexpr size_t word_count = N / sizeof(uint64_t);
+
+    std::atomic<uint32_t> seq_{0};
+    std::array<std::atomic<uint64_t>, word_count> words_{};
+
+    [[nodiscard]] bytes read_words() const noexcept {
+        std::array<uint64_t, word_count> out{};
+        for (size_t i = 0; i < word_count; ++i) {
+            out[i] = words_[i].load(std::memory_order_relaxed);
+        }
+        return std::bit_cast<bytes>(out);
+    }
+
+    void write_words(const bytes& in) noexcept {
+        const auto words = std::bit_cast<std::array<uint64_t, word_count>>(in);
+        for (size_t i = 0; i < word_count; ++i) {
+            words_[i].store(words[i], std::memory_order_relaxed);
+        }
+    }
+
+    [[nodiscard]] uint32_t lock() noexcept {
+        auto seq = seq_.load(std::memory_order_relaxed);
+        for (;;) {
+            if ((seq & 1U) != 0) {
+                atomic_spin_pause();
+                seq = seq_.load(std::memory_order_relaxed);
+            } else if (seq_.compare_exchange_weak(seq, seq + 1, std::memory_order_acquire,
+                                                  std::memory_order_relaxed)) {
+                std::atomic_thread_fence(std::memory_order_release);
+                return seq;
+            }
+        }
+    }
+
+    // Returns a consistent snapshot along with the (even) sequence number it
+    // was taken at.
+    [[nodiscard]] std::pair<bytes, uint32_t> snapshot() const noexcept {
+        for (;;) {
+            const auto seq = seq_.load(std::memory_order_acquire);
+            if ((seq & 1U) != 0) {
+                atomic_spin_pause();
+                continue;
+            }
+            auto out = read_words();
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (seq_.load(std::memory_order_relaxed) == seq) { return {out, seq}; }
+        }
+    }
+
+  public:
+    explicit seqlock_storage(const bytes& init) noexcept { write_words(init); }
+
+    // The memory order arguments only exist for parity with the lock-free
+    // storages. The sequence lock always provides acquire/release ordering.
+    [[nodiscard]] bytes load(std::memory_order /*order*/ = std::memory_order_seq_cst) const
+        noexcept {
+        return snapshot().first;
+    }
+
+    void store(const bytes& desired,
+               std::memory_order /*order*/ = std::memory_order_seq_cst) noexcept {
+        const auto seq = lock();
+        write_words(desired);
+        seq_.store(seq + 2, std::memory_order_release);
+    }
+
+    [[nodiscard]] bytes exchange(
+        const bytes& desired,
+        std::memory_order /*order*/ = std::memory_order_seq_cst) noexcept {
+        const auto seq = lock();
+        auto prev = read_words();
+        write_words(desired);
+        seq_.store(seq + 2, std::memory_order_release);
+        return prev;
+    }
+
+    bool compare_exchange(
+        bytes& expected,
+        const bytes& desired,
+        std::memory_order /*success*/ = std::memory_order_seq_cst,
+        std::memory_order /*failure*/ = std::memory_order_seq_cst) noexcept {
+        const auto seq = lock();
+        auto cur = read_words();
+        if (cur != expected) {
+            // nothing was written, so the sequence number is restored
+            seq_.store(seq, std::memory_order_release);
+            expected = cur;
+            return false;
+        }
+        write_words(desired);
+        seq_.store(seq + 2, std::memory_order_release);
+        return true;
+    }
+
+    // Applies `func` to the current bytes under the write lock. `func` must
+    // not throw.
+    template <typename F>
+    void update(F&& func) noexcept {
+        const auto seq = lock();
+        auto cur = read_words();
+        std::forward<F>(func)(cur);
+        write_words(cur);
+        seq_.store(seq + 2, std::memory_order_release);
+    }
+
+    void wait(const bytes& old,
+              std::memory_order /*order*/ = std::memory_order_seq_cst) const noexcept {
+        for (;;) {
+            const auto [cur, seq] = snapshot();
+            if (cur != old) { return; }
+            seq_.wait(seq, std::memory_order_acquire);
+        }
+    }
+
+    void notify_one() noexcept { seq_.notify_one(); }
+
+    void notify_all() noexcept { seq_.notify_all(); }
+};
+
+template <size_t N>
+struct packed_atomic_storage {
+    using type = seqlock_storage<N>;
+};
+
+template <>
+struct packed_atomic_storage<8> {
+    using type = std::conditional_t<packed_atomic8::is_always_lock_free,
+                                    packed_atomic8,
+                                    seqlock_storage<8>>;
+};
+
+#ifdef SUMTY_HAS_PACKED_ATOMIC16
+template <>
+struct packed_atomic_storage<16> {
+    using type = packed_atomic16;
+};
+#endif
+
+template <size_t N>
+using packed_atomic_storage_t = typename packed_atomic_storage<N>::type;
+
+} // namespace sumty::detail
+
+#endif
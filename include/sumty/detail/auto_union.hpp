@@ -37,19 +37,15 @@ template <>
 union auto_union<> {
     constexpr auto_union() noexcept {}
 
-    constexpr auto_union([[maybe_unused]] const auto_union& other) noexcept {}
+    constexpr auto_union(const auto_union&) noexcept = default;
 
-    constexpr auto_union([[maybe_unused]] auto_union&& other) noexcept {}
+    constexpr auto_union(auto_union&&) noexcept = default;
 
-    constexpr ~auto_union() noexcept {}
+    constexpr ~auto_union() noexcept = default;
 
-    constexpr auto_union& operator=([[maybe_unused]] const auto_union& rhs) noexcept {
-        return *this;
-    }
+    constexpr auto_union& operator=(const auto_union&) noexcept = default;
 
-    constexpr auto_union& operator=([[maybe_unused]] auto_union&& rhs) noexcept {
-        return *this;
-    }
+    constexpr auto_union& operator=(auto_union&&) noexcept = default;
 };
 
 template <typename T0, typename... TN>
@@ -59,16 +55,36 @@ union auto_union<T0, TN...> {
 
     constexpr auto_union() noexcept {}
 
+    constexpr auto_union(const auto_union&) noexcept
+        requires(all_trivially_copyable_v<T0, TN...>)
+    = default;
+
     constexpr auto_union([[maybe_unused]] const auto_union& other) noexcept {}
 
+    constexpr auto_union(auto_union&&) noexcept
+        requires(all_trivially_copyable_v<T0, TN...>)
+    = default;
+
     constexpr auto_union([[maybe_unused]] auto_union&& other) noexcept {}
 
+    constexpr ~auto_union() noexcept
+        requires(all_trivially_copyable_v<T0, TN...>)
+    = default;
+
     constexpr ~auto_union() noexcept {}
 
+    constexpr auto_union& operator=(const auto_union&) noexcept
+        requires(all_trivially_copyable_v<T0, TN...>)
+    = default;
+
     constexpr auto_union& operator=([[maybe_unused]] const auto_union& rhs) noexcept {
         return *this;
     }
 
+    constexpr auto_union& operator=(auto_union&&) noexcept
+        requires(all_trivially_copyable_v<T0, TN...>)
+    = default;
+
     constexpr auto_union& operator=([[maybe_unused]] auto_union&& rhs) noexcept {
         return *this;
     }
@@ -119,16 +135,36 @@ union auto_union<T0&&, TN...> {
 
     constexpr auto_union() noexcept {}
 
+    constexpr auto_union(const auto_union&) noexcept
+        requires(all_trivially_copyable_v<T0&&, TN...>)
+    = default;
+
     constexpr auto_union([[maybe_unused]] const auto_union& other) noexcept {}
 
+    constexpr auto_union(auto_union&&) noexcept
+        requires(all_trivially_copyable_v<T0&&, TN...>)
+    = default;
+
     constexpr auto_union([[maybe_unused]] auto_union&& other) noexcept {}
 
+    constexpr ~auto_union() noexcept
+        requires(all_trivially_copyable_v<T0&&, TN...>)
+    = default;
+
     constexpr ~auto_union() noexcept {}
 
+    constexpr auto_union& operator=(const auto_union&) noexcept
+        requires(all_trivially_copyable_v<T0&&, TN...>)
+    = default;
+
     constexpr auto_union& operator=([[maybe_unused]] const auto_union& rhs) noexcept {
         return *this;
     }
 
+    constexpr auto_union& operator=(auto_union&&) noexcept
+        requires(all_trivially_copyable_v<T0&&, TN...>)
+    = default;
+
     constexpr auto_union& operator=([[maybe_unused]] auto_union&& rhs) noexcept {
         return *this;
     }
@@ -179,16 +215,36 @@ union auto_union<T0&, TN...> {
 
     constexpr auto_union() noexcept {}
 
+    constexpr auto_union(const auto_union&) noexcept
+        requires(all_trivially_copyable_v<T0&, TN...>)
+    = default;
+
     constexpr auto_union([[maybe_unused]] const auto_union& other) noexcept {}
 
+    constexpr auto_union(auto_union&&) noexcept
+        requires(all_trivially_copyable_v<T0&, TN...>)
+    = default;
+
     constexpr auto_union([[maybe_unused]] auto_union&& other) noexcept {}
 
+    constexpr ~auto_union() noexcept
+        requires(all_trivially_copyable_v<T0&, TN...>)
+    = default;
+
     constexpr ~auto_union() noexcept {}
 
+    constexpr auto_union& operator=(const auto_union&) noexcept
+        requires(all_trivially_copyable_v<T0&, TN...>)
+    = default;
+
     constexpr auto_union& operator=([[maybe_unused]] const auto_union& rhs) noexcept {
         return *this;
     }
 
+    constexpr auto_union& operator=(auto_union&&) noexcept
+        requires(all_trivially_copyable_v<T0&, TN...>)
+    = default;
+
     constexpr auto_union& operator=([[maybe_unused]] auto_union&& rhs) noexcept {
         return *this;
     }
@@ -234,16 +290,36 @@ union auto_union<void, TN...> {
 
     constexpr auto_union() noexcept {}
 
+    constexpr auto_union(const auto_union&) noexcept
+        requires(all_trivially_copyable_v<void, TN...>)
+    = default;
+
     constexpr auto_union([[maybe_unused]] const auto_union& other) noexcept {}
 
+    constexpr auto_union(auto_union&&) noexcept
+        requires(all_trivially_copyable_v<void, TN...>)
+    = default;
+
     constexpr auto_union([[maybe_unused]] auto_union&& other) noexcept {}
 
+    constexpr ~auto_union() noexcept
+        requires(all_trivially_copyable_v<void, TN...>)
+    = default;
+
     constexpr ~auto_union() noexcept {}
 
+    constexpr auto_union& operator=(const auto_union&) noexcept
+        requires(all_trivially_copyable_v<void, TN...>)
+    = default;
+
     constexpr auto_union& operator=([[maybe_unused]] const auto_union& rhs) noexcept {
         return *this;
     }
 
+    constexpr auto_union& operator=(auto_union&&) noexcept
+        requires(all_trivially_copyable_v<void, TN...>)
+    = default;
+
     constexpr auto_union& operator=([[maybe_unused]] auto_union&& rhs) noexcept {
         return *this;
     }
@@ -0,0 +1,114 @@
+/* Copyright 2024 Jack A Bernard Jr.
+ *
+ * Licensed under the Apache License, Version 2.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SUMTY_DETAIL_HASH_HPP
+#define SUMTY_DETAIL_HASH_HPP
+
+#include "sumty/utils.hpp"
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace sumty::detail {
+
+template <typename T>
+concept std_hashable = std::is_default_constructible_v<std::hash<T>> &&
+                       requires(const std::hash<T>& hasher, const T& value) {
+                           { hasher(value) } -> std::convertible_to<size_t>;
+                       };
+
+// Types that are hashed through std::hash if it is enabled, or else by their
+// bytes if every value has a unique object representation. `void` and
+// references are handled by the callers.
+template <typename T>
+static inline constexpr bool is_hashable_v =
+    std::is_void_v<T> || std_hashable<std::remove_cvref_t<T>> ||
+    std::has_unique_object_representations_v<std::remove_cvref_t<T>>;
+
+constexpr size_t hash_mix(size_t seed, size_t value) noexcept {
+    return seed ^ (value + size_t{0x9e3779b97f4a7c15} + (seed << 6U) + (seed >> 2U));
+}
+
+template <typename T>
+size_t hash_bytes(const T& value) noexcept {
+    const auto* bytes = reinterpret_cast<const char*>(std::addressof(value));
+    if constexpr (sizeof(T) <= sizeof(uint64_t)) {
+        // small values are loaded into a single word and finalized as in
+        // MurmurHash3, which compilers reduce to one load and a few ALU ops
+        uint64_t bits = 0;
+        for (size_t i = 0; i < sizeof(T); ++i) {
+            bits |= uint64_t{static_cast<unsigned char>(bytes[i])} << (i * 8U);
+        }
+        bits ^= bits >> 33U;
+        bits *= uint64_t{0xff51afd7ed558ccd};
+        bits ^= bits >> 33U;
+        return bits;
+    } else {
+        return std::hash<std::string_view>{}(std::string_view(bytes, sizeof(T)));
+    }
+}
+
+template <typename T>
+size_t hash_value(const T& value) {
+    if constexpr (std::is_same_v<T, void_t>) {
+        return 0;
+    } else if constexpr (std_hashable<T>) {
+        return std::hash<T>{}(value);
+    } else {
+        static_assert(std::has_unique_object_representations_v<T>,
+                      "type must have a std::hash specialization or unique object "
+                      "representations to be hashed");
+        return hash_bytes(value);
+    }
+}
+
+// Keys of type U that are guaranteed to hash the same as the equal value of
+// an alternative of type T. Comparing equal is not enough, since for example
+// 5.0 == 5 but std::hash<double> and std::hash<int> disagree. Only keys of
+// the same type, and string-like keys of std::basic_string alternatives,
+// qualify.
+template <typename U, typename T>
+static inline constexpr bool is_hash_key_for_v =
+    std::is_same_v<std::remove_cvref_t<U>, std::remove_cvref_t<T>>;
+
+template <typename U, typename C, typename A>
+static inline constexpr bool
+    is_hash_key_for_v<U, std::basic_string<C, std::char_traits<C>, A>> =
+        std::is_convertible_v<const U&, std::basic_string_view<C>>;
+
+// Hashes a heterogeneous key the same way as the equal value of the
+// alternative type T, which must not be a reference. String-like keys are
+// hashed as a basic_string_view, which std::hash guarantees to agree with
+// std::basic_string.
+template <typename T, typename U>
+    requires is_hash_key_for_v<U, T>
+size_t hash_key(const U& key) {
+    if constexpr (std::is_same_v<U, T>) {
+        return hash_value(key);
+    } else {
+        using view_t = std::basic_string_view<typename T::value_type>;
+        return std::hash<view_t>{}(view_t(key));
+    }
+}
+
+} // namespace sumty::detail
+
+#endif
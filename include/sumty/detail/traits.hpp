@@ -47,6 +47,8 @@ struct traits {
     static inline constexpr bool is_destructible = std::is_destructible_v<value_type>;
     static inline constexpr bool is_nothrow_destructible =
         std::is_nothrow_destructible_v<value_type>;
+    static inline constexpr bool is_trivially_copyable =
+        std::is_trivially_copyable_v<value_type>;
     static inline constexpr bool is_copy_assignable = std::is_copy_assignable_v<T>;
     static inline constexpr bool is_nothrow_copy_assignable =
         std::is_nothrow_copy_assignable_v<T>;
@@ -100,6 +102,7 @@ struct traits<T&> {
     static inline constexpr bool is_nothrow_move_constructible = true;
     static inline constexpr bool is_destructible = true;
     static inline constexpr bool is_nothrow_destructible = true;
+    static inline constexpr bool is_trivially_copyable = true;
     static inline constexpr bool is_copy_assignable = true;
     static inline constexpr bool is_nothrow_copy_assignable = true;
     static inline constexpr bool is_move_assignable = true;
@@ -152,6 +155,7 @@ struct traits<void> {
     static inline constexpr bool is_nothrow_move_constructible = true;
     static inline constexpr bool is_destructible = true;
     static inline constexpr bool is_nothrow_destructible = true;
+    static inline constexpr bool is_trivially_copyable = true;
     static inline constexpr bool is_copy_assignable = true;
     static inline constexpr bool is_nothrow_copy_assignable = true;
     static inline constexpr bool is_move_assignable = true;
@@ -179,6 +183,29 @@ struct traits<void> {
         traits<void_t>::is_nothrow_assignable<U> || std::is_void_v<U>;
 };
 
+struct niche_t {};
+
+static inline constexpr niche_t niche{};
+
+// Opt-in for types that have an otherwise unused object representation (a
+// niche), which variant<void, T> (and thus option<T>) can use to represent
+// the void alternative without a separate discriminant. Specializations must
+// provide:
+//
+//   static inline constexpr bool has_niche = true;
+//   static T make_niche() noexcept;
+//   static bool is_niche(const T& value) noexcept;
+//
+// Copying or assigning a niche value must produce a niche value.
+template <typename T>
+struct niche_traits {
+    static inline constexpr bool has_niche = false;
+};
+
+template <typename... T>
+static inline constexpr bool all_trivially_copyable_v =
+    (true && ... && traits<T>::is_trivially_copyable);
+
 } // namespace sumty::detail
 
 #endif
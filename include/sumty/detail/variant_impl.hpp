@@ -226,10 +226,18 @@ class variant_impl {
         traits<first_t<T...>>::is_nothrow_default_constructible)
         : variant_impl(std::in_place_index<0>) {}
 
+    constexpr variant_impl(const variant_impl&)
+        requires(all_trivially_copyable_v<T...>)
+    = default;
+
     constexpr variant_impl(const variant_impl& other) : discrim_(other.discrim_) {
         copy_construct<0>(other.data_);
     }
 
+    constexpr variant_impl(variant_impl&&) noexcept
+        requires(all_trivially_copyable_v<T...>)
+    = default;
+
     constexpr variant_impl(variant_impl&& other) noexcept(
         (true && ... && traits<T>::is_nothrow_move_constructible))
         : discrim_(other.discrim_) {
@@ -246,11 +254,19 @@ class variant_impl {
         data_.template construct<I>(std::forward<Args>(args)...);
     }
 
+    constexpr ~variant_impl() noexcept
+        requires(all_trivially_copyable_v<T...>)
+    = default;
+
     constexpr ~variant_impl() noexcept((true && ... &&
                                         traits<T>::is_nothrow_destructible)) {
         destroy<0>();
     }
 
+    constexpr variant_impl& operator=(const variant_impl&)
+        requires(all_trivially_copyable_v<T...>)
+    = default;
+
     constexpr variant_impl& operator=(const variant_impl& rhs) {
         if (this != &rhs) {
             if (discrim_ == rhs.discrim_) {
@@ -264,6 +280,10 @@ class variant_impl {
         return *this;
     }
 
+    constexpr variant_impl& operator=(variant_impl&&) noexcept
+        requires(all_trivially_copyable_v<T...>)
+    = default;
+
     constexpr variant_impl& operator=(variant_impl&& rhs) noexcept((
         true && ... &&
         (traits<T>::is_nothrow_move_assignable &&
@@ -300,8 +320,7 @@ class variant_impl {
         } else if constexpr (std::is_lvalue_reference_v<select_t<I, T...>>) {
             return data_.template get<I>();
         } else {
-            auto ret = std::move(data_.template get<I>());
-            return ret;
+            return std::move(data_.template get<I>());
         }
     }
 
@@ -313,8 +332,7 @@ class variant_impl {
         } else if constexpr (std::is_lvalue_reference_v<select_t<I, T...>>) {
             return data_.template get<I>();
         } else {
-            auto ret = std::move(data_.template get<I>());
-            return ret;
+            return std::move(data_.template get<I>());
         }
     }
 
@@ -378,10 +396,18 @@ class variant_impl<void, T> {
         data_.template construct<0>();
     }
 
+    constexpr variant_impl(const variant_impl&)
+        requires(traits<T>::is_trivially_copyable)
+    = default;
+
     constexpr variant_impl(const variant_impl& other) {
         data_.template construct<0>(other.data_.template get<0>());
     }
 
+    constexpr variant_impl(variant_impl&&) noexcept
+        requires(traits<T>::is_trivially_copyable)
+    = default;
+
     constexpr variant_impl(variant_impl&& other) noexcept(
         traits<T>::is_nothrow_move_constructible) {
         data_.template construct<0>(other.data_.template get<0>());
@@ -394,10 +420,18 @@ class variant_impl<void, T> {
         data_.template construct<0>(std::forward<Args>(args)...);
     }
 
+    constexpr ~variant_impl() noexcept
+        requires(traits<T>::is_trivially_copyable)
+    = default;
+
     constexpr ~variant_impl() noexcept(traits<T>::is_nothrow_destructible) {
         data_.template destroy<0>();
     }
 
+    constexpr variant_impl& operator=(const variant_impl&)
+        requires(traits<T>::is_trivially_copyable)
+    = default;
+
     constexpr variant_impl& operator=(const variant_impl& rhs) {
         if (this != &rhs) {
             if constexpr (std::is_lvalue_reference_v<T>) {
@@ -409,6 +443,10 @@ class variant_impl<void, T> {
         return *this;
     }
 
+    constexpr variant_impl& operator=(variant_impl&&) noexcept
+        requires(traits<T>::is_trivially_copyable)
+    = default;
+
     constexpr variant_impl& operator=(variant_impl&& rhs) noexcept(
         traits<T>::is_nothrow_move_assignable) {
         if constexpr (std::is_lvalue_reference_v<T>) {
@@ -1090,6 +1128,120 @@ class variant_impl<std::enable_if_t<(sizeof(T) <= sizeof(bool))>, T, U&> {
     }
 };
 
+// Stores the void alternative in the niche of T, so that the variant is the
+// same size as T.
+template <typename T>
+class variant_impl<std::enable_if_t<niche_traits<T>::has_niche>, void, T> {
+  private:
+    using niche_traits_t = niche_traits<T>;
+
+    T data_;
+
+  public:
+    constexpr variant_impl() noexcept : data_(niche_traits_t::make_niche()) {}
+
+    // NOLINTNEXTLINE(hicpp-explicit-conversions)
+    constexpr variant_impl([[maybe_unused]] uninit_t tag) noexcept : variant_impl() {}
+
+    explicit constexpr variant_impl(
+        [[maybe_unused]] std::in_place_index_t<0> inplace) noexcept
+        : variant_impl() {}
+
+    template <typename U>
+    explicit constexpr variant_impl([[maybe_unused]] std::in_place_index_t<0> inplace,
+                                    // NOLINTNEXTLINE(cppcoreguidelines-missing-std-forward)
+                                    [[maybe_unused]] U&& value) noexcept
+        : variant_impl() {}
+
+    template <typename... Args>
+    explicit constexpr variant_impl([[maybe_unused]] std::in_place_index_t<1> inplace,
+                                    Args&&... args)
+        : data_(std::forward<Args>(args)...) {}
+
+    [[nodiscard]] constexpr size_t index() const noexcept {
+        return static_cast<size_t>(!niche_traits_t::is_niche(data_));
+    }
+
+    template <size_t I>
+    [[nodiscard]] constexpr typename traits<select_t<I, void, T>>::reference
+    get() & noexcept {
+        if constexpr (I == 1) {
+            return data_;
+        } else {
+            return;
+        }
+    }
+
+    template <size_t I>
+    [[nodiscard]] constexpr typename traits<select_t<I, void, T>>::const_reference get()
+        const& noexcept {
+        if constexpr (I == 1) {
+            return data_;
+        } else {
+            return;
+        }
+    }
+
+    template <size_t I>
+    [[nodiscard]] constexpr typename traits<select_t<I, void, T>>::rvalue_reference
+    get() && noexcept {
+        if constexpr (I == 1) {
+            return std::move(data_);
+        } else {
+            return;
+        }
+    }
+
+    template <size_t I>
+    [[nodiscard]] constexpr typename traits<select_t<I, void, T>>::const_rvalue_reference
+    get() const&& noexcept {
+        if constexpr (I == 1) {
+            return std::move(data_);
+        } else {
+            return;
+        }
+    }
+
+    template <size_t I>
+    [[nodiscard]] constexpr typename traits<select_t<I, void, T>>::pointer ptr() noexcept {
+        if constexpr (I == 1) {
+            return &data_;
+        } else {
+            return;
+        }
+    }
+
+    template <size_t I>
+    [[nodiscard]] constexpr typename traits<select_t<I, void, T>>::const_pointer ptr()
+        const noexcept {
+        if constexpr (I == 1) {
+            return &data_;
+        } else {
+            return;
+        }
+    }
+
+    template <size_t I, typename... Args>
+    // NOLINTNEXTLINE(cppcoreguidelines-missing-std-forward)
+    constexpr void emplace([[maybe_unused]] Args&&... args) {
+        if constexpr (I == 1) {
+            data_ = T(std::forward<Args>(args)...);
+        } else {
+            data_ = niche_traits_t::make_niche();
+        }
+    }
+
+    template <size_t I, typename... Args>
+    constexpr void uninit_emplace(Args&&... args) {
+        emplace<I>(std::forward<Args>(args)...);
+    }
+
+    constexpr void swap(variant_impl& other) noexcept(traits<T>::is_nothrow_swappable) {
+        using std::swap;
+        swap(data_, other.data_);
+    }
+};
+
 } // namespace sumty::detail
 
 #endif
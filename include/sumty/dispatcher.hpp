@@ -0,0 +1,203 @@
+/* Copyright 2024 Jack A Bernard Jr.
+ *
+ * Licensed under the Apache License, Version 2.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SUMTY_DISPATCHER_HPP
+#define SUMTY_DISPATCHER_HPP
+
+#include "sumty/detail/utils.hpp"
+#include "sumty/utils.hpp"
+#include "sumty/variant.hpp"
+
+#include <cstddef>
+#include <functional>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace sumty {
+
+template <typename V, typename H>
+class dispatcher;
+
+/// @class dispatcher dispatcher.hpp <sumty/dispatcher.hpp>
+/// @brief Batched message dispatcher for @ref variant messages
+///
+/// @details
+/// @ref dispatcher drains batches of @ref variant messages, such as the
+/// contents of an actor mailbox, into a handler that is fixed at compile
+/// time. The handler is typically an @ref overload of one callable per
+/// alternative. For each alternative `M`, the handler must be callable with
+/// either a `std::span<M>` of messages, or with a single `M&&` message.
+///
+/// @ref dispatch groups a batch by alternative: messages are moved into a
+/// reusable buffer per alternative, and then the handler is called once per
+/// alternative with a span of all messages of that type. This replaces one
+/// visit per message with a single direct call per alternative, and lets
+/// handlers process same-typed messages in a tight loop. Messages of the same
+/// alternative are delivered in their original relative order, but the order
+/// across alternatives is not preserved.
+///
+/// When the order across alternatives matters, @ref dispatch_in_order calls
+/// the handler with each run of consecutive same-typed messages, so that
+/// messages are delivered in exactly their original order.
+///
+/// The per-alternative buffers grow to the largest batch seen and are then
+/// reused, so steady-state dispatch does not allocate. Every alternative
+/// must be an object type.
+///
+/// ## Example
+/// ```cpp
+/// struct order { uint64_t id; };
+/// struct cancel { uint64_t id; };
+///
+/// auto router = make_dispatcher<variant<order, cancel>>(overload(
+///     [](std::span<order> orders) { /* ... */ },
+///     [](cancel&& c) { /* ... */ }
+/// ));
+///
+/// std::vector<variant<order, cancel>> mailbox = /* ... */;
+/// router.dispatch(mailbox);
+/// ```
+///
+/// @tparam M The alternative types of the message @ref variant
+/// @tparam H The handler type
+template <typename... M, typename H>
+class dispatcher<variant<M...>, H> {
+  private:
+    static_assert((std::is_object_v<M> && ...),
+                  "dispatcher requires object types as alternatives");
+
+    SUMTY_NO_UNIQ_ADDR H handler_;
+    std::tuple<std::vector<M>...> buffers_{};
+
+    template <size_t I>
+    void handle(std::span<detail::select_t<I, M...>> msgs) {
+        using msg_t = detail::select_t<I, M...>;
+        if constexpr (std::is_invocable_v<H&, std::span<msg_t>>) {
+            std::invoke(handler_, msgs);
+        } else {
+            static_assert(std::is_invocable_v<H&, msg_t&&>,
+                          "handler must accept a span of messages or a single message");
+            for (auto& msg : msgs) { std::invoke(handler_, std::move(msg)); }
+        }
+    }
+
+    template <size_t I>
+    void flush() {
+        auto& buf = std::get<I>(buffers_);
+        if (buf.empty()) { return; }
+        // NOLINTNEXTLINE(cppcoreguidelines-special-member-functions)
+        struct clear_guard {
+            std::vector<detail::select_t<I, M...>>* buf;
+            ~clear_guard() { buf->clear(); }
+        } guard{&buf};
+        handle<I>(std::span(buf));
+    }
+
+    template <size_t... I>
+    void gather(variant<M...>& msg, [[maybe_unused]] std::index_sequence<I...> seq) {
+        const auto idx = msg.index();
+        static_cast<void>(
+            ((idx == I &&
+              (std::get<I>(buffers_).push_back(std::move(msg[index<I>])), true)) ||
+             ...));
+    }
+
+    // Drops any gathered messages, so that a batch interrupted by an
+    // exception does not leak into the next one.
+    void clear() noexcept {
+        std::apply([](auto&... bufs) { (bufs.clear(), ...); }, buffers_);
+    }
+
+    template <size_t... I>
+    void flush_all([[maybe_unused]] std::index_sequence<I...> seq) {
+        (flush<I>(), ...);
+    }
+
+    template <size_t... I>
+    void flush_one(size_t idx, [[maybe_unused]] std::index_sequence<I...> seq) {
+        static_cast<void>(((idx == I && (flush<I>(), true)) || ...));
+    }
+
+  public:
+    using message_type = variant<M...>;
+    using handler_type = H;
+
+    /// @brief Constructs a @ref dispatcher with the given handler
+    explicit dispatcher(H handler) noexcept(std::is_nothrow_move_constructible_v<H>)
+        : handler_(std::move(handler)) {}
+
+    /// @brief Gets the handler
+    [[nodiscard]] H& handler() noexcept { return handler_; }
+
+    /// @brief Gets the handler
+    [[nodiscard]] const H& handler() const noexcept { return handler_; }
+
+    /// @brief Dispatches a batch of messages, grouped by alternative
+    ///
+    /// @details
+    /// Every message in `batch` is moved from. The handler is called at
+    /// most once per alternative, in order of alternative index. If the
+    /// handler throws, the remaining messages of the batch are discarded.
+    void dispatch(std::span<variant<M...>> batch) {
+        try {
+            for (auto& msg : batch) { gather(msg, std::index_sequence_for<M...>{}); }
+            flush_all(std::index_sequence_for<M...>{});
+        } catch (...) {
+            clear();
+            throw;
+        }
+    }
+
+    /// @brief Dispatches a batch of messages in their original order
+    ///
+    /// @details
+    /// Every message in `batch` is moved from. Runs of consecutive messages
+    /// holding the same alternative are delivered to the handler together.
+    void dispatch_in_order(std::span<variant<M...>> batch) {
+        if (batch.empty()) { return; }
+        try {
+            auto run_idx = batch.front().index();
+            for (auto& msg : batch) {
+                if (msg.index() != run_idx) {
+                    flush_one(run_idx, std::index_sequence_for<M...>{});
+                    run_idx = msg.index();
+                }
+                gather(msg, std::index_sequence_for<M...>{});
+            }
+            flush_one(run_idx, std::index_sequence_for<M...>{});
+        } catch (...) {
+            clear();
+            throw;
+        }
+    }
+};
+
+/// @relates dispatcher
+/// @brief Creates a @ref dispatcher for messages of type `V`
+///
+/// @details
+/// `V` must be a @ref variant, and must be specified explicitly. The handler
+/// type is deduced.
+template <typename V, typename H>
+dispatcher<V, std::decay_t<H>> make_dispatcher(H&& handler) {
+    return dispatcher<V, std::decay_t<H>>(std::forward<H>(handler));
+}
+
+} // namespace sumty
+
+#endif
@@ -0,0 +1,201 @@
+/* Copyright 2024 Jack A Bernard Jr.
+ *
+ * Licensed under the Apache License, Version 2.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SUMTY_ERROR_MESSAGE_HPP
+#define SUMTY_ERROR_MESSAGE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace sumty {
+
+/// @class error_message error_message.hpp <sumty/error_message.hpp>
+/// @brief Error message string that avoids heap allocation
+///
+/// @details
+/// Using `std::string` as the error type of a @ref result allocates for every
+/// error with a message that does not fit in the small string buffer of the
+/// standard library, which is typically only 15 characters. @ref
+/// error_message instead stores messages of up to @ref inline_capacity
+/// characters inline, and can refer to string literals, or any other string
+/// with static storage duration, without copying them (see @ref
+/// from_static). Only longer messages with dynamic lifetime are copied to the
+/// heap.
+///
+/// Moving an @ref error_message never allocates and never copies more than
+/// the size of the @ref error_message itself.
+///
+/// @ref error_message is implicitly constructible from `const char*`,
+/// `std::string_view`, and `std::string`, so it can be used directly with
+/// @ref error, @ref result, and @ref error_set.
+///
+/// ## Example
+/// ```cpp
+/// result<int, error_message> parse(std::string_view str) {
+///     if (str.empty()) {
+///         return error<error_message>(error_message::from_static("empty input"));
+///     }
+///     if (str.size() > 10) {
+///         return error<error_message>("input too long");
+///     }
+///     return static_cast<int>(str.size());
+/// }
+///
+/// auto res = parse("");
+/// assert(res.error() == "empty input");
+/// assert(res.error().is_static());
+/// ```
+class error_message {
+  public:
+    /// @brief The maximum number of characters stored inline
+    static constexpr size_t inline_capacity = 47;
+
+  private:
+    enum class kind : uint8_t { inline_str, static_str, heap_str };
+
+    struct external {
+        const char* ptr;
+        size_t len;
+    };
+
+    union storage {
+        // NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays,hicpp-avoid-c-arrays)
+        char buf[inline_capacity + 1];
+        external ext;
+    };
+
+    storage data_{};
+    uint8_t inline_len_{0};
+    kind kind_{kind::inline_str};
+
+    void assign(std::string_view str) {
+        if (str.size() <= inline_capacity) {
+            std::memcpy(&data_.buf[0], str.data(), str.size());
+            data_.buf[str.size()] = '\0';
+            inline_len_ = static_cast<uint8_t>(str.size());
+            kind_ = kind::inline_str;
+        } else {
+            auto* ptr = new char[str.size() + 1];
+            std::memcpy(ptr, str.data(), str.size());
+            ptr[str.size()] = '\0';
+            data_.ext = external{ptr, str.size()};
+            kind_ = kind::heap_str;
+        }
+    }
+
+    void release() noexcept {
+        if (kind_ == kind::heap_str) { delete[] data_.ext.ptr; }
+    }
+
+    void steal(error_message& other) noexcept {
+        data_ = other.data_;
+        inline_len_ = other.inline_len_;
+        kind_ = other.kind_;
+        other.data_.buf[0] = '\0';
+        other.inline_len_ = 0;
+        other.kind_ = kind::inline_str;
+    }
+
+  public:
+    /// @brief Constructs an empty @ref error_message
+    error_message() noexcept = default;
+
+    error_message(const error_message& other) {
+        if (other.kind_ == kind::heap_str) {
+            assign(other.view());
+        } else {
+            data_ = other.data_;
+            inline_len_ = other.inline_len_;
+            kind_ = other.kind_;
+        }
+    }
+
+    error_message(error_message&& other) noexcept { steal(other); }
+
+    // NOLINTNEXTLINE(hicpp-explicit-conversions)
+    error_message(std::string_view str) { assign(str); }
+
+    // NOLINTNEXTLINE(hicpp-explicit-conversions)
+    error_message(const char* str) { assign(str); }
+
+    // NOLINTNEXTLINE(hicpp-explicit-conversions)
+    error_message(const std::string& str) { assign(str); }
+
+    ~error_message() noexcept { release(); }
+
+    error_message& operator=(const error_message& rhs) {
+        if (this != &rhs) { *this = error_message(rhs); }
+        return *this;
+    }
+
+    error_message& operator=(error_message&& rhs) noexcept {
+        if (this != &rhs) {
+            release();
+            steal(rhs);
+        }
+        return *this;
+    }
+
+    /// @brief Creates an @ref error_message that refers to a string with
+    /// static storage duration, such as a string literal, without copying it.
+    ///
+    /// @details
+    /// The string must outlive every @ref error_message that refers to it,
+    /// and must be null terminated at `str.size()`.
+    [[nodiscard]] static error_message from_static(std::string_view str) noexcept {
+        error_message ret;
+        ret.data_.ext = external{str.data(), str.size()};
+        ret.kind_ = kind::static_str;
+        return ret;
+    }
+
+    [[nodiscard]] const char* c_str() const noexcept {
+        return kind_ == kind::inline_str ? &data_.buf[0] : data_.ext.ptr;
+    }
+
+    [[nodiscard]] const char* data() const noexcept { return c_str(); }
+
+    [[nodiscard]] size_t size() const noexcept {
+        return kind_ == kind::inline_str ? inline_len_ : data_.ext.len;
+    }
+
+    [[nodiscard]] bool empty() const noexcept { return size() == 0; }
+
+    [[nodiscard]] std::string_view view() const noexcept { return {c_str(), size()}; }
+
+    /// @brief Checks if the message is stored inside the @ref error_message
+    [[nodiscard]] bool is_inline() const noexcept { return kind_ == kind::inline_str; }
+
+    /// @brief Checks if the message refers to a string with static storage
+    /// duration
+    [[nodiscard]] bool is_static() const noexcept { return kind_ == kind::static_str; }
+
+    // NOLINTNEXTLINE(hicpp-explicit-conversions)
+    operator std::string_view() const noexcept { return view(); }
+
+    [[nodiscard]] std::string str() const { return std::string(view()); }
+
+    friend bool operator==(const error_message& lhs, std::string_view rhs) noexcept {
+        return lhs.view() == rhs;
+    }
+};
+
+} // namespace sumty
+
+#endif
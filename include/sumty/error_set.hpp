@@ -17,13 +17,17 @@
 #define SUMTY_ERROR_SET_HPP
 
 #include "sumty/detail/fwd.hpp"    // IWYU pragma: export
+#include "sumty/detail/hash.hpp"
 #include "sumty/detail/traits.hpp" // IWYU pragma: export
 #include "sumty/detail/utils.hpp"
 #include "sumty/utils.hpp"
 #include "sumty/variant.hpp"
 
+#include <array>
 #include <cstddef>
+#include <cstdint>
 #include <initializer_list>
+#include <string_view>
 #include <type_traits>
 #include <utility>
 
@@ -772,8 +776,61 @@ constexpr void swap(error_set<T...>& a, error_set<T...>& b)
     a.swap(b);
 }
 
+/// @brief Severity of an error, as reported by @ref describe
+enum class error_severity : uint8_t { debug, info, warning, error, critical };
+
+/// @brief Static description of an error type, as returned by @ref describe
+struct error_description {
+    std::string_view name;
+    int code;
+    error_severity severity;
+};
+
+/// @brief Customization point that describes an error type
+///
+/// @details
+/// Specializations may define any of the following static constexpr
+/// members. Members that are not defined take the default shown.
+///
+/// ```cpp
+/// template <>
+/// struct sumty::error_descriptor<my_error> {
+///     static constexpr std::string_view name = "my_error"; // default: ""
+///     static constexpr int code = 42;                      // default: 0
+///     static constexpr error_severity severity =           // default: error
+///         error_severity::warning;
+/// };
+/// ```
+template <typename E>
+struct error_descriptor {};
+
 namespace detail {
 
+template <typename E>
+consteval error_description make_error_description() noexcept {
+    using desc_t = error_descriptor<std::remove_cvref_t<E>>;
+    error_description ret{"", 0, error_severity::error};
+    if constexpr (requires { desc_t::name; }) { ret.name = desc_t::name; }
+    if constexpr (requires { desc_t::code; }) { ret.code = desc_t::code; }
+    if constexpr (requires { desc_t::severity; }) { ret.severity = desc_t::severity; }
+    return ret;
+}
+
+template <typename... T>
+static inline constexpr std::array<error_description, sizeof...(T)> error_description_table{
+    make_error_description<T>()...};
+
+template <typename E, typename T>
+struct error_set_index_helper;
+
+template <typename E, typename... T>
+struct error_set_index_helper<E, error_set<T...>>
+    : std::integral_constant<size_t, index_of_v<E, T...>> {};
+
+template <typename E, typename... T>
+struct error_set_index_helper<E, const error_set<T...>>
+    : error_set_index_helper<E, error_set<T...>> {};
+
 template <typename T>
 struct error_set_size_helper;
 
@@ -907,6 +964,79 @@ struct make_error_set : detail::make_error_set_helper<T...> {};
 template <typename... T>
 using make_error_set_t = typename make_error_set<T...>::type;
 
+/// @brief Gets the index of error type `E` in the @ref error_set `ES`
+///
+/// @details
+/// The index matches @ref error_set::index, which makes it suitable for
+/// indexing flat arrays of per-error data, such as counters.
+///
+/// ## Example
+/// ```cpp
+/// using errors = error_set<parse_error, io_error>;
+///
+/// std::array<size_t, error_set_size_v<errors>> counts{};
+/// ++counts[error_set_index_v<io_error, errors>];
+/// ```
+template <typename E, typename ES>
+struct error_set_index : detail::error_set_index_helper<E, ES> {};
+
+template <typename E, typename ES>
+static inline constexpr size_t error_set_index_v = error_set_index<E, ES>::value;
+
+/// @relates error_set
+/// @brief Gets the static description of the error contained in an
+/// @ref error_set
+///
+/// @details
+/// The descriptions of all alternatives are computed at compile time from
+/// @ref error_descriptor and stored in a table indexed by the discriminant of
+/// the @ref error_set, so this function is a single table lookup.
+///
+/// ## Example
+/// ```cpp
+/// struct timeout {};
+///
+/// template <>
+/// struct sumty::error_descriptor<timeout> {
+///     static constexpr std::string_view name = "timeout";
+///     static constexpr int code = 408;
+///     static constexpr error_severity severity = error_severity::warning;
+/// };
+///
+/// error_set<timeout, std::error_code> err = timeout{};
+///
+/// assert(describe(err).name == "timeout");
+/// assert(describe(err).code == 408);
+/// ```
+template <typename... T>
+constexpr error_description describe(const error_set<T...>& err) noexcept {
+    return detail::error_description_table<T...>[err.index()];
+}
+
 } // namespace sumty
 
+namespace std {
+
+/// @relates sumty::error_set
+/// @brief `std::hash` specialization for @ref sumty::error_set
+///
+/// @details
+/// The hash combines the index of the held error type with the hash of the
+/// error, which is computed with `std::hash` if it is enabled for the error
+/// type, or else bytewise if it has unique object representations.
+template <typename... T>
+#ifndef DOXYGEN
+    requires(sumty::detail::is_hashable_v<T> && ...)
+#endif
+struct hash<sumty::error_set<T...>> {
+    size_t operator()(const sumty::error_set<T...>& err) const {
+        return err.visit_informed([](const auto& value, auto info) {
+            return sumty::detail::hash_mix(decltype(info)::index,
+                                           sumty::detail::hash_value(value));
+        });
+    }
+};
+
+} // namespace std
+
 #endif
@@ -16,7 +16,11 @@
 #ifndef SUMTY_EXCEPTIONS_HPP
 #define SUMTY_EXCEPTIONS_HPP
 
+#include "sumty/utils.hpp"
+
 #include <exception>
+#include <type_traits>
+#include <utility>
 
 namespace sumty {
 
@@ -103,6 +107,31 @@ class bad_result_access<void> : public std::exception {
     [[nodiscard]] const char* what() const noexcept override { return "bad result access"; }
 };
 
+namespace detail {
+
+// The throwing paths of the checked accessors are outlined into these cold,
+// non-inlined helpers so that only the discriminant check and a predicted
+// branch remain inline at each call site.
+
+[[noreturn]] SUMTY_COLD inline void throw_bad_variant_access() {
+    throw bad_variant_access();
+}
+
+[[noreturn]] SUMTY_COLD inline void throw_bad_option_access() {
+    throw bad_option_access();
+}
+
+[[noreturn]] SUMTY_COLD inline void throw_bad_result_access() {
+    throw bad_result_access<void>();
+}
+
+template <typename E>
+[[noreturn]] SUMTY_COLD void throw_bad_result_access(E&& error) {
+    throw bad_result_access<std::remove_cvref_t<E>>(std::forward<E>(error));
+}
+
+} // namespace detail
+
 } // namespace sumty
 
 #endif
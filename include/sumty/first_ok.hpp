@@ -0,0 +1,242 @@
+/* Copyright 2024 Jack A Bernard Jr.
+ *
+ * Licensed under the Apache License, Version 2.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SUMTY_FIRST_OK_HPP
+#define SUMTY_FIRST_OK_HPP
+
+#include "sumty/detail/utils.hpp"
+#include "sumty/oneshot.hpp"
+#include "sumty/option.hpp"
+#include "sumty/result.hpp"
+#include "sumty/utils.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <stop_token>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace sumty {
+
+namespace detail {
+
+template <typename T>
+struct is_duration : std::false_type {};
+
+template <typename Rep, typename Period>
+struct is_duration<std::chrono::duration<Rep, Period>> : std::true_type {};
+
+template <typename T>
+static inline constexpr bool is_duration_v = is_duration<T>::value;
+
+template <typename F>
+decltype(auto) invoke_strategy(F& func, std::stop_token token) {
+    if constexpr (std::is_invocable_v<F&, std::stop_token>) {
+        return std::invoke(func, std::move(token));
+    } else {
+        return std::invoke(func);
+    }
+}
+
+template <typename F>
+using strategy_result_t = std::remove_cvref_t<decltype(invoke_strategy(
+    std::declval<std::decay_t<F>&>(), std::declval<std::stop_token>()))>;
+
+template <typename... F>
+struct first_ok_types {
+    static_assert(sizeof...(F) > 0, "first_ok requires at least one strategy");
+    static_assert((is_result_v<strategy_result_t<F>> && ...),
+                  "first_ok strategies must return a result");
+
+    using value_type = typename strategy_result_t<first_t<F...>>::value_type;
+
+    static_assert(
+        (std::is_same_v<typename strategy_result_t<F>::value_type, value_type> && ...),
+        "first_ok strategies must all have the same value type");
+
+    using error_type = std::tuple<option<typename strategy_result_t<F>::error_type>...>;
+    using result_type = result<value_type, error_type>;
+};
+
+template <typename R, typename T, typename E>
+R first_ok_value(result<T, E>&& res) {
+    if constexpr (std::is_void_v<T>) {
+        return R{};
+    } else {
+        return R{std::in_place, *std::move(res)};
+    }
+}
+
+template <typename T, typename E>
+struct first_ok_state {
+    oneshot<T, E> done{};
+    std::stop_source stop{};
+    E errors{};
+    std::atomic<size_t> failures{0};
+};
+
+// Runs the strategy at index I, and delivers the final result if it is the
+// first to succeed, or the last to fail.
+template <size_t I, typename R, size_t N, typename T, typename E, typename F>
+void run_strategy(first_ok_state<T, E>& state, F& func) {
+    if (state.stop.stop_requested()) { return; }
+    auto res = invoke_strategy(func, state.stop.get_token());
+    if (res.has_value()) {
+        if (state.done.set(first_ok_value<R>(std::move(res)))) {
+            state.stop.request_stop();
+        }
+    } else {
+        std::get<I>(state.errors).emplace(std::move(res).error());
+        if (state.failures.fetch_add(1, std::memory_order_acq_rel) == N - 1) {
+            state.done.set(R{in_place_error, std::move(state.errors)});
+        }
+    }
+}
+
+template <typename Ex, typename Task>
+void execute(Ex& executor, Task&& task) {
+    if constexpr (requires { executor.execute(std::forward<Task>(task)); }) {
+        executor.execute(std::forward<Task>(task));
+    } else {
+        std::invoke(executor, std::forward<Task>(task));
+    }
+}
+
+} // namespace detail
+
+/// @relates result
+/// @brief Runs several strategies concurrently and returns the first
+/// successful @ref result
+///
+/// @details
+/// Each strategy in `funcs` is a callable that returns a @ref result, and
+/// optionally accepts a `std::stop_token`. All strategies must have the same
+/// value type. Every strategy is submitted to `executor`, which is called
+/// with a nullary task as `executor.execute(task)` if that is valid, or as
+/// `executor(task)` otherwise.
+///
+/// The calling thread blocks until one of the strategies succeeds, and its
+/// value is returned. At that point, a stop is requested on the
+/// `std::stop_token` passed to the other strategies, so that they can give
+/// up early, and strategies that have not started yet are skipped. The
+/// remaining strategies may still be running when this function returns, so
+/// they must not refer to objects that are local to the caller.
+///
+/// If every strategy fails, an error is returned that holds the error of
+/// each strategy, in the order of `funcs`.
+///
+/// The strategies must not throw.
+///
+/// ## Example
+/// ```cpp
+/// auto res = first_ok(
+///     pool,
+///     [key] { return cache_lookup(key); },
+///     [key](std::stop_token stop) { return index_lookup(key, stop); },
+///     [key](std::stop_token stop) { return recompute(key, stop); }
+/// );
+/// ```
+///
+/// @param executor The executor that runs the strategies
+/// @param funcs The strategies
+/// @return The value of the first successful strategy, or a `std::tuple` of
+/// an @ref option of the error of each strategy.
+template <typename Ex, typename... F>
+#ifndef DOXYGEN
+    requires(!detail::is_duration_v<std::remove_cvref_t<Ex>>)
+#endif
+typename detail::first_ok_types<F...>::result_type first_ok(Ex&& executor, F&&... funcs) {
+    using types = detail::first_ok_types<F...>;
+    using result_t = typename types::result_type;
+    using state_t =
+        detail::first_ok_state<typename types::value_type, typename types::error_type>;
+
+    auto state = std::make_shared<state_t>();
+    [&]<size_t... I>([[maybe_unused]] std::index_sequence<I...> seq) {
+        (detail::execute(executor,
+                         [state, func = std::forward<F>(funcs)]() mutable {
+                             detail::run_strategy<I, result_t, sizeof...(F)>(*state, func);
+                         }),
+         ...);
+    }(std::index_sequence_for<F...>{});
+    return state->done.wait();
+}
+
+/// @relates result
+/// @brief Runs several strategies in order on the calling thread and returns
+/// the first successful @ref result
+///
+/// @details
+/// This is a sequential fallback for @ref first_ok, for use when there are
+/// not enough cores to run the strategies concurrently. The strategies are
+/// called in the order of `funcs` until one of them succeeds. A strategy
+/// that accepts a `std::stop_token` is passed one that is never stopped.
+///
+/// `timeout` bounds the total time spent: once it has elapsed, no further
+/// strategies are started. A strategy that is already running is not
+/// interrupted.
+///
+/// If no strategy succeeds, an error is returned that holds the error of
+/// each strategy that was called, and `none` for each strategy that was not
+/// started because of the timeout.
+///
+/// ## Example
+/// ```cpp
+/// auto res = first_ok(
+///     std::chrono::milliseconds(5),
+///     [key] { return cache_lookup(key); },
+///     [key] { return index_lookup(key); },
+///     [key] { return recompute(key); }
+/// );
+/// ```
+///
+/// @param timeout The time after which no further strategies are started
+/// @param funcs The strategies
+/// @return The value of the first successful strategy, or a `std::tuple` of
+/// an @ref option of the error of each strategy.
+template <typename Rep, typename Period, typename... F>
+typename detail::first_ok_types<F...>::result_type first_ok(
+    std::chrono::duration<Rep, Period> timeout, F&&... funcs) {
+    using types = detail::first_ok_types<F...>;
+    using result_t = typename types::result_type;
+
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    typename types::error_type errors{};
+    option<result_t> ret{};
+    [&]<size_t... I>([[maybe_unused]] std::index_sequence<I...> seq) {
+        static_cast<void>(
+            ((std::chrono::steady_clock::now() < deadline &&
+              [&](auto& func) {
+                  auto res = detail::invoke_strategy(func, std::stop_token{});
+                  if (res.has_value()) {
+                      ret.emplace(detail::first_ok_value<result_t>(std::move(res)));
+                      return false;
+                  }
+                  std::get<I>(errors).emplace(std::move(res).error());
+                  return true;
+              }(funcs)) &&
+             ...));
+    }(std::index_sequence_for<F...>{});
+    if (ret.has_value()) { return *std::move(ret); }
+    return result_t{in_place_error, std::move(errors)};
+}
+
+} // namespace sumty
+
+#endif
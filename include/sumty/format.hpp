@@ -0,0 +1,406 @@
+/* Copyright 2024 Jack A Bernard Jr.
+ *
+ * Licensed under the Apache License, Version 2.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SUMTY_FORMAT_HPP
+#define SUMTY_FORMAT_HPP
+
+#include "sumty/error_set.hpp"
+#include "sumty/option.hpp"
+#include "sumty/result.hpp"
+#include "sumty/utils.hpp"
+#include "sumty/variant.hpp"
+
+#include <cstddef>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#if __has_include(<format>)
+#include <format>
+#endif
+
+namespace sumty::detail {
+
+template <typename T>
+static inline constexpr bool is_void_like_v =
+    std::is_void_v<T> || std::is_same_v<std::remove_cvref_t<T>, void_t>;
+
+// Stands in for the formatter of a void alternative, which formats as
+// nothing and accepts no format spec.
+struct void_formatter {};
+
+template <typename Backend, typename T, typename Char>
+using alt_formatter_t =
+    std::conditional_t<is_void_like_v<T>, void_formatter,
+                       typename Backend::template formatter<std::remove_cvref_t<T>, Char>>;
+
+template <typename Backend, typename T, typename Char>
+static inline constexpr bool is_formattable_v =
+    std::is_default_constructible_v<alt_formatter_t<Backend, T, Char>>;
+
+template <typename Char, typename Out>
+Out write_literal(Out out, std::string_view str) {
+    for (const char chr : str) { *out++ = chr; }
+    return out;
+}
+
+// Holds one formatter per alternative of a sum type.
+//
+// The format spec is split on `|` into one spec per alternative, in order, so
+// that `{:x|>8}` formats the first alternative with `x` and the second with
+// `>8`. A spec without any `|` applies to every non-void alternative, and
+// otherwise void alternatives take an empty spec. Nested replacement fields are not
+// supported, and a `|` fill character is only supported when there is a
+// single alternative.
+template <typename Backend, typename Char, typename... T>
+class alternatives_formatter {
+  private:
+    SUMTY_NO_UNIQ_ADDR std::tuple<alt_formatter_t<Backend, T, Char>...> fmts_{};
+
+    template <size_t I>
+    constexpr void parse_alt(std::basic_string_view<Char> spec) {
+        if constexpr (is_void_like_v<select_t<I, T...>>) {
+            if (!spec.empty()) { Backend::error("void alternative takes no format spec"); }
+        } else {
+            typename Backend::template parse_context<Char> ctx(spec);
+            auto it = std::get<I>(fmts_).parse(ctx);
+            if (it != ctx.end()) { Backend::error("invalid format spec for alternative"); }
+        }
+    }
+
+  public:
+    template <typename ParseContext>
+    constexpr auto parse(ParseContext& ctx) {
+        const std::basic_string_view<Char> spec_rest(ctx.begin(), ctx.end());
+        const auto spec = spec_rest.substr(0, spec_rest.find(Char{'}'}));
+        if (spec.find(Char{'{'}) != spec.npos) {
+            Backend::error("nested replacement fields are not supported");
+        }
+        if constexpr (sizeof...(T) == 1) {
+            parse_alt<0>(spec);
+        } else if (spec.find(Char{'|'}) == spec.npos) {
+            [&]<size_t... I>([[maybe_unused]] std::index_sequence<I...> seq) {
+                ((is_void_like_v<T> ? void() : parse_alt<I>(spec)), ...);
+            }(std::index_sequence_for<T...>{});
+        } else {
+            auto rest = spec;
+            [&]<size_t... I>([[maybe_unused]] std::index_sequence<I...> seq) {
+                (
+                    [&] {
+                        const auto len = I + 1 == sizeof...(T) ? rest.size()
+                                                               : rest.find(Char{'|'});
+                        if (len == rest.npos) {
+                            Backend::error("too few alternative specs");
+                        }
+                        parse_alt<I>(rest.substr(0, len));
+                        rest.remove_prefix(len == rest.size() ? len : len + 1);
+                    }(),
+                    ...);
+            }(std::index_sequence_for<T...>{});
+            if (rest.find(Char{'|'}) != rest.npos) {
+                Backend::error("too many alternative specs");
+            }
+        }
+        return ctx.begin() + static_cast<std::ptrdiff_t>(spec.size());
+    }
+
+    template <size_t I, typename U, typename FormatContext>
+    auto format_alt(const U& value, FormatContext& ctx) const {
+        if constexpr (is_void_like_v<select_t<I, T...>>) {
+            return ctx.out();
+        } else {
+            return std::get<I>(fmts_).format(value, ctx);
+        }
+    }
+};
+
+template <typename Backend, typename Char, typename... T>
+class variant_formatter : public alternatives_formatter<Backend, Char, T...> {
+  public:
+    template <typename V, typename FormatContext>
+    auto format(const V& var, FormatContext& ctx) const {
+        return var.visit_informed([this, &ctx](const auto& value, auto info) {
+            constexpr size_t IDX = decltype(info)::index;
+            if constexpr (is_void_like_v<select_t<IDX, T...>>) {
+                return write_literal<Char>(ctx.out(), "()");
+            } else {
+                return this->template format_alt<IDX>(value, ctx);
+            }
+        });
+    }
+};
+
+template <typename Backend, typename Char, typename T>
+class option_formatter : public alternatives_formatter<Backend, Char, T> {
+  public:
+    template <typename FormatContext>
+    auto format(const option<T>& opt, FormatContext& ctx) const {
+        if (!opt.has_value()) { return write_literal<Char>(ctx.out(), "none"); }
+        ctx.advance_to(write_literal<Char>(ctx.out(), "some("));
+        if constexpr (!std::is_void_v<T>) {
+            ctx.advance_to(this->template format_alt<0>(*opt, ctx));
+        }
+        return write_literal<Char>(ctx.out(), ")");
+    }
+};
+
+template <typename Backend, typename Char, typename T, typename E>
+class result_formatter : public alternatives_formatter<Backend, Char, T, E> {
+  public:
+    template <typename FormatContext>
+    auto format(const result<T, E>& res, FormatContext& ctx) const {
+        if (res.has_value()) {
+            ctx.advance_to(write_literal<Char>(ctx.out(), "ok("));
+            if constexpr (!std::is_void_v<T>) {
+                ctx.advance_to(this->template format_alt<0>(*res, ctx));
+            }
+        } else {
+            ctx.advance_to(write_literal<Char>(ctx.out(), "error("));
+            if constexpr (!std::is_void_v<E>) {
+                ctx.advance_to(this->template format_alt<1>(res.error(), ctx));
+            }
+        }
+        return write_literal<Char>(ctx.out(), ")");
+    }
+};
+
+// Formats ok_t and error_t as `ok(<value>)` and `error(<value>)`.
+template <typename Backend, typename Char, typename T, bool IS_ERROR>
+class wrapper_formatter : public alternatives_formatter<Backend, Char, T> {
+  public:
+    template <typename W, typename FormatContext>
+    auto format(const W& wrapper, FormatContext& ctx) const {
+        ctx.advance_to(write_literal<Char>(ctx.out(), IS_ERROR ? "error(" : "ok("));
+        if constexpr (!std::is_void_v<T>) {
+            ctx.advance_to(this->template format_alt<0>(*wrapper, ctx));
+        }
+        return write_literal<Char>(ctx.out(), ")");
+    }
+};
+
+template <typename Backend, typename Char>
+class none_formatter {
+  public:
+    template <typename ParseContext>
+    constexpr auto parse(ParseContext& ctx) {
+        auto it = ctx.begin();
+        if (it != ctx.end() && *it != Char{'}'}) {
+            Backend::error("none takes no format spec");
+        }
+        return it;
+    }
+
+    template <typename FormatContext>
+    auto format([[maybe_unused]] none_t value, FormatContext& ctx) const {
+        return write_literal<Char>(ctx.out(), "none");
+    }
+};
+
+#ifdef __cpp_lib_format
+struct std_format_backend {
+    template <typename T, typename Char>
+    using formatter = std::formatter<T, Char>;
+
+    template <typename Char>
+    using parse_context = std::basic_format_parse_context<Char>;
+
+    [[noreturn]] static void error(const char* msg) { throw std::format_error(msg); }
+};
+#endif
+
+#ifdef FMT_VERSION
+struct fmt_format_backend {
+    template <typename T, typename Char>
+    using formatter = fmt::formatter<T, Char>;
+
+    template <typename Char>
+    using parse_context = fmt::basic_format_parse_context<Char>;
+
+    [[noreturn]] static void error(const char* msg) { throw fmt::format_error(msg); }
+};
+#endif
+
+} // namespace sumty::detail
+
+#ifdef __cpp_lib_format
+
+namespace std {
+
+/// @relates variant
+/// @brief `std::formatter` specialization for @ref variant
+///
+/// @details
+/// The held alternative is written directly to the output with its own
+/// formatter, and a `void` alternative is written as `()`. The format spec
+/// is split on `|` into one spec per alternative, so that `{:x|>8}` formats a
+/// `variant<int, std::string>` holding an `int` with `x`, or holding a
+/// `std::string` with `>8`. A spec without any `|` is forwarded to every
+/// alternative.
+///
+/// The formatters for @ref option, @ref result, @ref error_set, @ref ok_t,
+/// @ref error_t, and @ref none_t follow the same rules, writing `some(...)`,
+/// `none`, `ok(...)` and `error(...)` around the contained value, with
+/// nothing inside the parentheses for `void`.
+///
+/// These formatters are also provided for `fmt::formatter` if
+/// `<fmt/format.h>` is included before this header.
+///
+/// ## Example
+/// ```cpp
+/// variant<int, std::string> v{std::in_place_index<0>, 255};
+/// result<int, std::string> res{in_place_error, "oops"};
+///
+/// assert(std::format("{:x|>8}", v) == "ff");
+/// assert(std::format("{}", res) == "error(oops)");
+/// ```
+template <typename... T, typename Char>
+#ifndef DOXYGEN
+    requires(sumty::detail::is_formattable_v<sumty::detail::std_format_backend, T, Char> &&
+             ...)
+#endif
+struct formatter<sumty::variant<T...>, Char>
+    : sumty::detail::variant_formatter<sumty::detail::std_format_backend, Char, T...> {
+};
+
+/// @relates error_set
+/// @brief `std::formatter` specialization for @ref error_set
+///
+/// @details
+/// See the `std::formatter` specialization for @ref variant.
+template <typename... T, typename Char>
+#ifndef DOXYGEN
+    requires(sumty::detail::is_formattable_v<sumty::detail::std_format_backend, T, Char> &&
+             ...)
+#endif
+struct formatter<sumty::error_set<T...>, Char>
+    : sumty::detail::variant_formatter<sumty::detail::std_format_backend, Char, T...> {
+};
+
+/// @relates option
+/// @brief `std::formatter` specialization for @ref option
+///
+/// @details
+/// See the `std::formatter` specialization for @ref variant.
+template <typename T, typename Char>
+#ifndef DOXYGEN
+    requires(sumty::detail::is_formattable_v<sumty::detail::std_format_backend, T, Char>)
+#endif
+struct formatter<sumty::option<T>, Char>
+    : sumty::detail::option_formatter<sumty::detail::std_format_backend, Char, T> {
+};
+
+/// @relates result
+/// @brief `std::formatter` specialization for @ref result
+///
+/// @details
+/// See the `std::formatter` specialization for @ref variant.
+template <typename T, typename E, typename Char>
+#ifndef DOXYGEN
+    requires(sumty::detail::is_formattable_v<sumty::detail::std_format_backend, T, Char> &&
+             sumty::detail::is_formattable_v<sumty::detail::std_format_backend, E, Char>)
+#endif
+struct formatter<sumty::result<T, E>, Char>
+    : sumty::detail::result_formatter<sumty::detail::std_format_backend, Char, T, E> {
+};
+
+/// @relates ok_t
+/// @brief `std::formatter` specialization for @ref ok_t
+///
+/// @details
+/// See the `std::formatter` specialization for @ref variant.
+template <typename T, typename Char>
+#ifndef DOXYGEN
+    requires(sumty::detail::is_formattable_v<sumty::detail::std_format_backend, T, Char>)
+#endif
+struct formatter<sumty::ok_t<T>, Char>
+    : sumty::detail::wrapper_formatter<sumty::detail::std_format_backend, Char, T,
+                                       false> {};
+
+/// @relates error_t
+/// @brief `std::formatter` specialization for @ref error_t
+///
+/// @details
+/// See the `std::formatter` specialization for @ref variant.
+template <typename E, typename Char>
+#ifndef DOXYGEN
+    requires(sumty::detail::is_formattable_v<sumty::detail::std_format_backend, E, Char>)
+#endif
+struct formatter<sumty::error_t<E>, Char>
+    : sumty::detail::wrapper_formatter<sumty::detail::std_format_backend, Char, E,
+                                       true> {};
+
+/// @relates none_t
+/// @brief `std::formatter` specialization for @ref none_t
+template <typename Char>
+struct formatter<sumty::none_t, Char>
+    : sumty::detail::none_formatter<sumty::detail::std_format_backend, Char> {};
+
+} // namespace std
+
+#endif
+
+#if defined(FMT_VERSION) && !defined(DOXYGEN)
+
+namespace fmt {
+
+template <typename... T, typename Char>
+    requires(sumty::detail::is_formattable_v<sumty::detail::fmt_format_backend, T, Char> &&
+             ...)
+struct formatter<sumty::variant<T...>, Char>
+    : sumty::detail::variant_formatter<sumty::detail::fmt_format_backend, Char, T...> {
+};
+
+template <typename... T, typename Char>
+    requires(sumty::detail::is_formattable_v<sumty::detail::fmt_format_backend, T, Char> &&
+             ...)
+struct formatter<sumty::error_set<T...>, Char>
+    : sumty::detail::variant_formatter<sumty::detail::fmt_format_backend, Char, T...> {
+};
+
+template <typename T, typename Char>
+    requires(sumty::detail::is_formattable_v<sumty::detail::fmt_format_backend, T, Char>)
+struct formatter<sumty::option<T>, Char>
+    : sumty::detail::option_formatter<sumty::detail::fmt_format_backend, Char, T> {
+};
+
+template <typename T, typename E, typename Char>
+    requires(sumty::detail::is_formattable_v<sumty::detail::fmt_format_backend, T, Char> &&
+             sumty::detail::is_formattable_v<sumty::detail::fmt_format_backend, E, Char>)
+struct formatter<sumty::result<T, E>, Char>
+    : sumty::detail::result_formatter<sumty::detail::fmt_format_backend, Char, T, E> {
+};
+
+template <typename T, typename Char>
+    requires(sumty::detail::is_formattable_v<sumty::detail::fmt_format_backend, T, Char>)
+struct formatter<sumty::ok_t<T>, Char>
+    : sumty::detail::wrapper_formatter<sumty::detail::fmt_format_backend, Char, T,
+                                       false> {};
+
+template <typename E, typename Char>
+    requires(sumty::detail::is_formattable_v<sumty::detail::fmt_format_backend, E, Char>)
+struct formatter<sumty::error_t<E>, Char>
+    : sumty::detail::wrapper_formatter<sumty::detail::fmt_format_backend, Char, E,
+                                       true> {};
+
+template <typename Char>
+struct formatter<sumty::none_t, Char>
+    : sumty::detail::none_formatter<sumty::detail::fmt_format_backend, Char> {};
+
+} // namespace fmt
+
+#endif
+
+#endif
@@ -0,0 +1,217 @@
+/* Copyright 2024 Jack A Bernard Jr.
+ *
+ * Licensed under the Apache License, Version 2.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SUMTY_FSM_HPP
+#define SUMTY_FSM_HPP
+
+#include "sumty/detail/utils.hpp"
+#include "sumty/utils.hpp"
+#include "sumty/variant.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+namespace sumty {
+
+namespace detail {
+
+template <bool COUNT, size_t N>
+struct fsm_counters {
+    std::array<uint64_t, N> counts{};
+
+    constexpr void record(size_t cell) noexcept { ++counts[cell]; }
+};
+
+template <size_t N>
+struct fsm_counters<false, N> {
+    constexpr void record([[maybe_unused]] size_t cell) noexcept {}
+};
+
+} // namespace detail
+
+template <typename States, typename Events, typename Transitions, bool COUNT = false>
+class fsm;
+
+/// @class fsm fsm.hpp <sumty/fsm.hpp>
+/// @brief Table-driven finite state machine over @ref variant states and
+/// events
+///
+/// @details
+/// @ref fsm holds the current state as a @ref variant of state types, and
+/// processes events from a @ref variant of event types. The behavior is
+/// defined by `Transitions`, typically an @ref overload of callables, each of
+/// which accepts a state by mutable reference and an event by rvalue
+/// reference:
+///
+/// - If it returns one of the state types, the machine transitions to that
+///   state. The new state is constructed with @ref variant::emplace in the
+///   storage of the old state, and may be built by moving from the old
+///   state's payload.
+/// - If it returns `variant<S...>`, the machine transitions to that state.
+/// - If it returns `void`, the machine stays in the current state, which the
+///   callable may have modified in place.
+///
+/// An event for which `Transitions` has no matching callable in the current
+/// state is ignored.
+///
+/// The combination of every state and event is resolved at compile time
+/// into a constexpr table of `|S| × |E|` function pointers, so processing an
+/// event is a single indexed call, rather than two nested visits. For
+/// machines with at most 16 combinations, the table is replaced by a chain
+/// of comparisons that the compiler can turn into a switch with every
+/// transition inlined.
+///
+/// When `COUNT` is `true`, the machine also records how many times each
+/// combination of state and event caused a transition (see
+/// @ref transition_count).
+///
+/// ## Example
+/// ```cpp
+/// struct idle {};
+/// struct connecting { std::string host; };
+/// struct connected { std::string host; };
+///
+/// struct connect { std::string host; };
+/// struct established {};
+/// struct drop {};
+///
+/// auto transitions = overload(
+///     [](idle&, connect&& ev) { return connecting{std::move(ev.host)}; },
+///     [](connecting& s, established&&) { return connected{std::move(s.host)}; },
+///     [](auto&, drop&&) { return idle{}; }
+/// );
+///
+/// fsm<variant<idle, connecting, connected>,
+///     variant<connect, established, drop>,
+///     decltype(transitions)> machine{idle{}, transitions};
+///
+/// machine.dispatch(connect{"example.com"});
+/// machine.dispatch(established{});
+/// assert(machine.index() == 2);
+/// ```
+///
+/// @tparam States A @ref variant of state types
+/// @tparam Events A @ref variant of event types
+/// @tparam Transitions The type of the transition callable
+/// @tparam COUNT Enables per-transition counters
+template <typename... S, typename... E, typename Transitions, bool COUNT>
+class fsm<variant<S...>, variant<E...>, Transitions, COUNT> {
+  private:
+    static_assert((std::is_object_v<S> && ...) && (std::is_object_v<E> && ...),
+                  "fsm states and events must be object types");
+
+    static constexpr size_t state_count = sizeof...(S);
+    static constexpr size_t event_count = sizeof...(E);
+    static constexpr size_t cell_count = state_count * event_count;
+
+    using cell_fn = bool (*)(fsm&, variant<E...>&);
+
+    variant<S...> state_;
+    SUMTY_NO_UNIQ_ADDR Transitions transitions_;
+    SUMTY_NO_UNIQ_ADDR detail::fsm_counters<COUNT, cell_count> counters_{};
+
+    template <size_t CELL>
+    static bool cell(fsm& self, variant<E...>& event) {
+        constexpr size_t SI = CELL / event_count;
+        constexpr size_t EI = CELL % event_count;
+        using state_t = detail::select_t<SI, S...>;
+        using event_t = detail::select_t<EI, E...>;
+        if constexpr (std::is_invocable_v<Transitions&, state_t&, event_t&&>) {
+            using ret_t = std::invoke_result_t<Transitions&, state_t&, event_t&&>;
+            static_assert(!std::is_reference_v<ret_t>,
+                          "transition must return the next state by value");
+            if constexpr (std::is_void_v<ret_t>) {
+                std::invoke(self.transitions_, self.state_[sumty::index<SI>],
+                            std::move(event[sumty::index<EI>]));
+            } else if constexpr (std::is_same_v<ret_t, variant<S...>>) {
+                self.state_ = std::invoke(self.transitions_, self.state_[sumty::index<SI>],
+                                          std::move(event[sumty::index<EI>]));
+            } else {
+                using next_t = std::remove_cvref_t<ret_t>;
+                static_assert((std::is_same_v<next_t, S> || ...),
+                              "transition must return a state type, the state variant, "
+                              "or void");
+                self.state_.template emplace<detail::index_of_v<next_t, S...>>(
+                    std::invoke(self.transitions_, self.state_[sumty::index<SI>],
+                                std::move(event[sumty::index<EI>])));
+            }
+            self.counters_.record(CELL);
+            return true;
+        } else {
+            return false;
+        }
+    }
+
+    template <size_t... CELL>
+    bool dispatch_impl(variant<E...>& event,
+                       [[maybe_unused]] std::index_sequence<CELL...> seq) {
+        const auto idx = state_.index() * event_count + event.index();
+        if constexpr (cell_count <= 16) {
+            bool handled = false;
+            static_cast<void>(
+                ((idx == CELL && (handled = cell<CELL>(*this, event), true)) || ...));
+            return handled;
+        } else {
+            static constexpr std::array<cell_fn, cell_count> table{&cell<CELL>...};
+            return table[idx](*this, event);
+        }
+    }
+
+  public:
+    using states_type = variant<S...>;
+    using events_type = variant<E...>;
+    using transitions_type = Transitions;
+
+    /// @brief Constructs an @ref fsm in its initial state
+    // NOLINTNEXTLINE(hicpp-explicit-conversions)
+    fsm(variant<S...> initial, Transitions transitions = Transitions{})
+        : state_(std::move(initial)), transitions_(std::move(transitions)) {}
+
+    /// @brief Processes an event
+    ///
+    /// @return `true` if the event was handled in the current state, or
+    /// `false` if it was ignored.
+    bool dispatch(variant<E...> event) {
+        return dispatch_impl(event, std::make_index_sequence<cell_count>{});
+    }
+
+    /// @brief Gets the current state
+    [[nodiscard]] const variant<S...>& state() const noexcept { return state_; }
+
+    /// @brief Gets the index of the current state
+    [[nodiscard]] size_t index() const noexcept { return state_.index(); }
+
+    /// @brief Gets the transition callable
+    [[nodiscard]] const Transitions& transitions() const noexcept { return transitions_; }
+
+    /// @brief Gets the number of events with index `event_idx` that were
+    /// handled in the state with index `state_idx`
+    [[nodiscard]] uint64_t transition_count(size_t state_idx,
+                                            size_t event_idx) const noexcept
+#ifndef DOXYGEN
+        requires(COUNT)
+#endif
+    {
+        return counters_.counts[state_idx * event_count + event_idx];
+    }
+};
+
+} // namespace sumty
+
+#endif
@@ -0,0 +1,215 @@
+/* Copyright 2024 Jack A Bernard Jr.
+ *
+ * Licensed under the Apache License, Version 2.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SUMTY_INTERNED_ERROR_HPP
+#define SUMTY_INTERNED_ERROR_HPP
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+namespace sumty {
+
+namespace detail {
+
+class intern_table {
+  public:
+    static constexpr size_t bucket_count = size_t{1} << 14;
+    static constexpr size_t max_entries = bucket_count / 2;
+
+  private:
+    struct entry {
+        const char* data;
+        size_t size;
+        size_t hash;
+    };
+
+    // Entries are stored in segments of doubling size, so that an id maps to
+    // its entry with a bit scan, and entries never move once published.
+    static constexpr size_t segment_count = std::bit_width(max_entries);
+
+    std::array<std::atomic<uint32_t>, bucket_count> buckets_{};
+    std::array<std::atomic<entry*>, segment_count> segments_{};
+    std::atomic<uint32_t> next_id_{1};
+
+    intern_table() noexcept = default;
+
+    [[nodiscard]] static size_t segment_of(uint32_t id) noexcept {
+        return static_cast<size_t>(std::bit_width(id)) - 1;
+    }
+
+    [[nodiscard]] entry& slot(uint32_t id) {
+        const auto seg = segment_of(id);
+        auto* entries = segments_[seg].load(std::memory_order_acquire);
+        if (entries == nullptr) {
+            auto* fresh = new entry[size_t{1} << seg];
+            if (segments_[seg].compare_exchange_strong(entries, fresh,
+                                                       std::memory_order_acq_rel,
+                                                       std::memory_order_acquire)) {
+                entries = fresh;
+            } else {
+                delete[] fresh;
+            }
+        }
+        return entries[id - (uint32_t{1} << seg)];
+    }
+
+    [[nodiscard]] const entry& get(uint32_t id) const noexcept {
+        const auto seg = segment_of(id);
+        return segments_[seg].load(std::memory_order_acquire)[id - (uint32_t{1} << seg)];
+    }
+
+    [[nodiscard]] uint32_t publish(std::string_view str, size_t hash) {
+        const auto id = next_id_.fetch_add(1, std::memory_order_relaxed);
+        if (id > max_entries) [[unlikely]] {
+            throw std::length_error("sumty::interned_error table is full");
+        }
+        auto* data = new char[str.size() + 1];
+        std::memcpy(data, str.data(), str.size());
+        data[str.size()] = '\0';
+        slot(id) = entry{data, str.size(), hash};
+        return id;
+    }
+
+  public:
+    [[nodiscard]] static intern_table& instance() noexcept {
+        static intern_table table{};
+        return table;
+    }
+
+    [[nodiscard]] uint32_t intern(std::string_view str) {
+        if (str.empty()) { return 0; }
+        const auto hash = std::hash<std::string_view>{}(str);
+        uint32_t fresh = 0;
+        for (size_t i = 0; i < bucket_count; ++i) {
+            auto& bucket = buckets_[(hash + i) & (bucket_count - 1)];
+            auto id = bucket.load(std::memory_order_acquire);
+            if (id == 0) {
+                // The entry is published before the bucket, so readers that
+                // observe the id in the bucket also observe the entry.
+                if (fresh == 0) { fresh = publish(str, hash); }
+                if (bucket.compare_exchange_strong(id, fresh, std::memory_order_acq_rel,
+                                                   std::memory_order_acquire)) {
+                    return fresh;
+                }
+            }
+            const auto& ent = get(id);
+            if (ent.hash == hash && std::string_view(ent.data, ent.size) == str) {
+                // If another thread won the race, the reserved id is left
+                // unused, but its entry remains valid.
+                return id;
+            }
+        }
+        throw std::length_error("sumty::interned_error table is full");
+    }
+
+    [[nodiscard]] std::string_view text(uint32_t id) const noexcept {
+        if (id == 0) { return {}; }
+        const auto& ent = get(id);
+        return {ent.data, ent.size};
+    }
+};
+
+} // namespace detail
+
+/// @class interned_error interned_error.hpp <sumty/interned_error.hpp>
+/// @brief 32-bit handle to an error message in a global intern table
+///
+/// @details
+/// @ref interned_error is intended for programs that produce a moderate
+/// number of distinct error messages a very large number of times. The
+/// message text is copied once into a global, lock-free, append-only table,
+/// and every @ref interned_error with equal text carries the same 32-bit id.
+/// As a result, an @ref interned_error is 4 bytes, comparing two instances
+/// is an integer comparison, and resolving the text is a single table load.
+///
+/// Interning is thread-safe, and interned text is never freed. The table can
+/// hold @ref capacity distinct messages. Interning
+/// a new message into a full table throws `std::length_error`.
+///
+/// ## Example
+/// ```cpp
+/// result<int, interned_error> parse(std::string_view str) {
+///     if (str.empty()) { return error<interned_error>("empty input"); }
+///     return static_cast<int>(str.size());
+/// }
+///
+/// auto res1 = parse("");
+/// auto res2 = parse("");
+///
+/// assert(res1.error() == res2.error());
+/// assert(res1.error().view() == "empty input");
+/// ```
+class interned_error {
+  private:
+    uint32_t id_{0};
+
+  public:
+    /// @brief The maximum number of distinct messages that can be interned
+    static constexpr size_t capacity = detail::intern_table::max_entries;
+
+    /// @brief Constructs an @ref interned_error with an empty message
+    constexpr interned_error() noexcept = default;
+
+    /// @brief Interns a message
+    // NOLINTNEXTLINE(hicpp-explicit-conversions)
+    interned_error(std::string_view message)
+        : id_(detail::intern_table::instance().intern(message)) {}
+
+    /// @brief Interns a message
+    // NOLINTNEXTLINE(hicpp-explicit-conversions)
+    interned_error(const char* message) : interned_error(std::string_view(message)) {}
+
+    /// @brief Interns a message
+    // NOLINTNEXTLINE(hicpp-explicit-conversions)
+    interned_error(const std::string& message)
+        : interned_error(std::string_view(message)) {}
+
+    /// @brief Gets the id of the interned message
+    [[nodiscard]] constexpr uint32_t id() const noexcept { return id_; }
+
+    /// @brief Gets the interned message text
+    ///
+    /// @details
+    /// The returned string is null terminated and remains valid for the
+    /// lifetime of the program.
+    [[nodiscard]] std::string_view view() const noexcept {
+        return detail::intern_table::instance().text(id_);
+    }
+
+    [[nodiscard]] const char* c_str() const noexcept {
+        return id_ == 0 ? "" : view().data();
+    }
+
+    [[nodiscard]] constexpr bool empty() const noexcept { return id_ == 0; }
+
+    // NOLINTNEXTLINE(hicpp-explicit-conversions)
+    operator std::string_view() const noexcept { return view(); }
+
+    friend constexpr bool operator==(interned_error lhs, interned_error rhs) noexcept {
+        return lhs.id_ == rhs.id_;
+    }
+};
+
+} // namespace sumty
+
+#endif
@@ -0,0 +1,614 @@
+/* Copyright 2024 Jack A Bernard Jr.
+ *
+ * Licensed under the Apache License, Version 2.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SUMTY_ITER_HPP
+#define SUMTY_ITER_HPP
+
+#include "sumty/option.hpp"
+#include "sumty/utils.hpp"
+
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+
+namespace sumty::iter {
+
+/// @brief Concept for pull-based iterators
+///
+/// @details
+/// An iterator has a member type `item_type`, and a member function `next()`
+/// that returns `option<item_type>`, which is `none` once the iterator is
+/// exhausted. `item_type` is usually either an lvalue reference, in which
+/// case `next()` returns a pointer-sized `option<T&>`, or a value type.
+template <typename I>
+concept iterator = std::movable<I> && requires(I& it) {
+    typename I::item_type;
+    { it.next() } -> std::same_as<option<typename I::item_type>>;
+};
+
+/// @brief The item type of an iterator
+template <typename I>
+using item_t = typename I::item_type;
+
+template <typename I>
+class ref_iter;
+
+template <typename I, typename F>
+class map_iter;
+
+template <typename I, typename P>
+class filter_iter;
+
+template <typename I>
+class take_iter;
+
+template <typename A, typename B>
+class chain_iter;
+
+template <typename A, typename B>
+class zip_iter;
+
+template <typename I, typename F>
+class flat_map_iter;
+
+template <typename I>
+class range_view;
+
+/// @class iterator_base iter.hpp <sumty/iter.hpp>
+/// @brief Adaptors and consumers shared by all iterators
+///
+/// @details
+/// @ref iterator_base is a CRTP base class that gives an iterator, in the
+/// sense of @ref iterator, the same adaptors as Rust's `Iterator` trait. An
+/// iterator only needs to define `item_type` and `next()`.
+///
+/// The adaptors consume the iterator they are called on, so they can only be
+/// called on rvalues. To adapt an iterator without giving it up, call
+/// @ref by_ref first. Adaptors are lazy, and do nothing until `next()` is
+/// called on the resulting iterator.
+///
+/// Compared to a stack of `std::views`, where every layer must implement
+/// `begin`, `end`, and sentinel comparison, and each step of an outer layer
+/// checks the inner layer's end separately from fetching its value, each
+/// layer of a stack of adaptors performs a single call to `next()` that
+/// returns both at once. When items are references, that is a single
+/// pointer that is null at the end.
+///
+/// ## Example
+/// ```cpp
+/// std::vector<std::string> lines = read_lines();
+///
+/// auto lengths = iter::from(lines)
+///     .filter([](const std::string& line) { return !line.empty(); })
+///     .map([](std::string& line) { return line.size(); })
+///     .take(10)
+///     .collect<std::vector<size_t>>();
+///
+/// auto it = iter::from(lines);
+/// while (option<std::string&> line = it.next()) {
+///     line->push_back('\n');
+/// }
+/// ```
+///
+/// @tparam Derived The iterator type
+template <typename Derived>
+class iterator_base {
+  private:
+    [[nodiscard]] Derived& self() noexcept { return static_cast<Derived&>(*this); }
+
+  public:
+    /// @brief Creates an iterator that calls `func` on each item
+    template <typename F>
+    [[nodiscard]] map_iter<Derived, std::decay_t<F>> map(F&& func) && {
+        return map_iter<Derived, std::decay_t<F>>(std::move(self()), std::forward<F>(func));
+    }
+
+    /// @brief Creates an iterator that only yields items for which `pred`
+    /// returns `true`
+    template <typename P>
+    [[nodiscard]] filter_iter<Derived, std::decay_t<P>> filter(P&& pred) && {
+        return filter_iter<Derived, std::decay_t<P>>(std::move(self()),
+                                                     std::forward<P>(pred));
+    }
+
+    /// @brief Creates an iterator that yields at most `count` items
+    [[nodiscard]] take_iter<Derived> take(size_t count) && {
+        return take_iter<Derived>(std::move(self()), count);
+    }
+
+    /// @brief Creates an iterator that yields the items of this iterator,
+    /// followed by the items of `other`
+    template <iterator I>
+    [[nodiscard]] chain_iter<Derived, I> chain(I other) && {
+        return chain_iter<Derived, I>(std::move(self()), std::move(other));
+    }
+
+    /// @brief Creates an iterator that yields pairs of items from this
+    /// iterator and `other`, until either is exhausted
+    template <iterator I>
+    [[nodiscard]] zip_iter<Derived, I> zip(I other) && {
+        return zip_iter<Derived, I>(std::move(self()), std::move(other));
+    }
+
+    /// @brief Creates an iterator that calls `func` on each item, and yields
+    /// the items of the returned iterator or range
+    template <typename F>
+    [[nodiscard]] flat_map_iter<Derived, std::decay_t<F>> flat_map(F&& func) && {
+        return flat_map_iter<Derived, std::decay_t<F>>(std::move(self()),
+                                                       std::forward<F>(func));
+    }
+
+    /// @brief Creates an iterator that advances this iterator without
+    /// consuming it
+    [[nodiscard]] ref_iter<Derived> by_ref() & noexcept {
+        return ref_iter<Derived>(self());
+    }
+
+    /// @brief Converts this iterator into a `std::ranges::input_range`
+    [[nodiscard]] range_view<Derived> as_range() && {
+        return range_view<Derived>(std::move(self()));
+    }
+
+    /// @brief Calls `func` on each remaining item
+    template <typename F>
+    void for_each(F&& func) {
+        while (auto item = self().next()) { std::invoke(func, *std::move(item)); }
+    }
+
+    /// @brief Combines the remaining items with `func`, starting from `init`
+    template <typename T, typename F>
+    [[nodiscard]] T fold(T init, F&& func) {
+        while (auto item = self().next()) {
+            init = std::invoke(func, std::move(init), *std::move(item));
+        }
+        return init;
+    }
+
+    /// @brief Consumes the remaining items and returns how many there were
+    [[nodiscard]] size_t count() {
+        size_t ret = 0;
+        while (self().next()) { ++ret; }
+        return ret;
+    }
+
+    /// @brief Inserts the remaining items at the end of a new container
+    template <typename C>
+    [[nodiscard]] C collect() {
+        C ret{};
+        while (auto item = self().next()) { ret.insert(ret.end(), *std::move(item)); }
+        return ret;
+    }
+};
+
+/// @class range_iter iter.hpp <sumty/iter.hpp>
+/// @brief Iterator over a `std::ranges` iterator and sentinel pair
+///
+/// @details
+/// Items are lvalue references if the underlying iterator yields lvalue
+/// references, and values otherwise. See @ref from.
+template <std::input_iterator It, std::sentinel_for<It> S>
+class range_iter : public iterator_base<range_iter<It, S>> {
+  private:
+    using reference = std::iter_reference_t<It>;
+
+    It it_;
+    SUMTY_NO_UNIQ_ADDR S end_;
+
+  public:
+    using item_type = std::conditional_t<std::is_lvalue_reference_v<reference>, reference,
+                                         std::remove_cvref_t<reference>>;
+
+    range_iter(It first, S last) : it_(std::move(first)), end_(std::move(last)) {}
+
+    option<item_type> next() {
+        if (it_ == end_) { return none; }
+        option<item_type> ret{std::in_place, *it_};
+        ++it_;
+        return ret;
+    }
+};
+
+/// @class owning_iter iter.hpp <sumty/iter.hpp>
+/// @brief Iterator that owns a range and moves its elements out
+///
+/// @details
+/// Copying or moving an @ref owning_iter copies or moves the range, and
+/// resumes at the same position in the new range. See @ref from.
+template <std::ranges::forward_range R>
+class owning_iter : public iterator_base<owning_iter<R>> {
+  private:
+    R range_;
+    size_t pos_;
+    std::ranges::iterator_t<R> it_;
+
+  public:
+    using item_type = std::ranges::range_value_t<R>;
+
+    explicit owning_iter(R&& range)
+        : range_(std::move(range)), pos_(0), it_(std::ranges::begin(range_)) {}
+
+    owning_iter(const owning_iter& other)
+        : range_(other.range_),
+          pos_(other.pos_),
+          it_(std::ranges::next(std::ranges::begin(range_),
+                                static_cast<std::ranges::range_difference_t<R>>(pos_))) {}
+
+    owning_iter(owning_iter&& other) noexcept(std::is_nothrow_move_constructible_v<R>)
+        : range_(std::move(other.range_)),
+          pos_(other.pos_),
+          it_(std::ranges::next(std::ranges::begin(range_),
+                                static_cast<std::ranges::range_difference_t<R>>(pos_))) {}
+
+    ~owning_iter() noexcept = default;
+
+    owning_iter& operator=(const owning_iter& rhs) {
+        if (this != &rhs) {
+            range_ = rhs.range_;
+            pos_ = rhs.pos_;
+            it_ = std::ranges::next(std::ranges::begin(range_),
+                                    static_cast<std::ranges::range_difference_t<R>>(pos_));
+        }
+        return *this;
+    }
+
+    owning_iter& operator=(owning_iter&& rhs) noexcept(
+        std::is_nothrow_move_assignable_v<R>) {
+        if (this != &rhs) {
+            range_ = std::move(rhs.range_);
+            pos_ = rhs.pos_;
+            it_ = std::ranges::next(std::ranges::begin(range_),
+                                    static_cast<std::ranges::range_difference_t<R>>(pos_));
+        }
+        return *this;
+    }
+
+    option<item_type> next() {
+        if (it_ == std::ranges::end(range_)) { return none; }
+        option<item_type> ret{std::in_place, std::ranges::iter_move(it_)};
+        ++it_;
+        ++pos_;
+        return ret;
+    }
+};
+
+/// @brief Creates an iterator over a `std::ranges` range
+///
+/// @details
+/// If `range` is an lvalue or a borrowed range, such as `std::span`, the
+/// iterator refers to its elements, and yields lvalue references if the
+/// range does. Otherwise, the range is moved into the iterator, which then
+/// yields the elements by value.
+///
+/// ## Example
+/// ```cpp
+/// std::vector<int> values{1, 2, 3};
+///
+/// auto refs = iter::from(values);               // yields int&
+/// auto owned = iter::from(std::move(values));   // yields int
+/// ```
+template <std::ranges::input_range R>
+[[nodiscard]] auto from(R&& range) {
+    if constexpr (std::is_lvalue_reference_v<R> || std::ranges::borrowed_range<R>) {
+        return range_iter<std::ranges::iterator_t<R>, std::ranges::sentinel_t<R>>(
+            std::ranges::begin(range), std::ranges::end(range));
+    } else {
+        return owning_iter<std::remove_cvref_t<R>>(std::forward<R>(range));
+    }
+}
+
+/// @class from_fn_iter iter.hpp <sumty/iter.hpp>
+/// @brief Iterator that calls a function to produce each item
+///
+/// @details
+/// See @ref from_fn.
+template <typename F>
+class from_fn_iter : public iterator_base<from_fn_iter<F>> {
+  private:
+    SUMTY_NO_UNIQ_ADDR F func_;
+
+  public:
+    using item_type = typename std::invoke_result_t<F&>::value_type;
+
+    explicit from_fn_iter(F func) : func_(std::move(func)) {}
+
+    option<item_type> next() { return std::invoke(func_); }
+};
+
+/// @brief Creates an iterator that calls `func` to produce each item
+///
+/// @details
+/// `func` must return an @ref option, and the iterator is exhausted when it
+/// returns `none`.
+///
+/// ## Example
+/// ```cpp
+/// int n = 0;
+/// auto counter = iter::from_fn([&n]() -> option<int> {
+///     if (n == 3) { return none; }
+///     return n++;
+/// });
+/// ```
+template <typename F>
+[[nodiscard]] from_fn_iter<std::decay_t<F>> from_fn(F&& func) {
+    return from_fn_iter<std::decay_t<F>>(std::forward<F>(func));
+}
+
+/// @class ref_iter iter.hpp <sumty/iter.hpp>
+/// @brief Iterator that advances another iterator by reference
+///
+/// @details
+/// See @ref iterator_base::by_ref.
+template <typename I>
+class ref_iter : public iterator_base<ref_iter<I>> {
+  private:
+    I* base_;
+
+  public:
+    using item_type = item_t<I>;
+
+    explicit ref_iter(I& base) noexcept : base_(std::addressof(base)) {}
+
+    option<item_type> next() { return base_->next(); }
+};
+
+/// @class map_iter iter.hpp <sumty/iter.hpp>
+/// @brief Iterator that transforms the items of another iterator
+///
+/// @details
+/// See @ref iterator_base::map.
+template <typename I, typename F>
+class map_iter : public iterator_base<map_iter<I, F>> {
+  private:
+    I base_;
+    SUMTY_NO_UNIQ_ADDR F func_;
+
+  public:
+    using item_type = std::invoke_result_t<F&, item_t<I>>;
+
+    static_assert(!std::is_void_v<item_type>, "map function must return a value");
+
+    map_iter(I base, F func) : base_(std::move(base)), func_(std::move(func)) {}
+
+    option<item_type> next() {
+        auto item = base_.next();
+        if (!item.has_value()) { return none; }
+        return option<item_type>{std::in_place, std::invoke(func_, *std::move(item))};
+    }
+};
+
+/// @class filter_iter iter.hpp <sumty/iter.hpp>
+/// @brief Iterator that skips the items of another iterator that do not
+/// satisfy a predicate
+///
+/// @details
+/// See @ref iterator_base::filter.
+template <typename I, typename P>
+class filter_iter : public iterator_base<filter_iter<I, P>> {
+  private:
+    I base_;
+    SUMTY_NO_UNIQ_ADDR P pred_;
+
+  public:
+    using item_type = item_t<I>;
+
+    filter_iter(I base, P pred) : base_(std::move(base)), pred_(std::move(pred)) {}
+
+    option<item_type> next() {
+        while (true) {
+            auto item = base_.next();
+            if (!item.has_value() || std::invoke(pred_, std::as_const(*item))) {
+                return item;
+            }
+        }
+    }
+};
+
+/// @class take_iter iter.hpp <sumty/iter.hpp>
+/// @brief Iterator that yields a limited number of items of another
+/// iterator
+///
+/// @details
+/// See @ref iterator_base::take.
+template <typename I>
+class take_iter : public iterator_base<take_iter<I>> {
+  private:
+    I base_;
+    size_t remaining_;
+
+  public:
+    using item_type = item_t<I>;
+
+    take_iter(I base, size_t count) : base_(std::move(base)), remaining_(count) {}
+
+    option<item_type> next() {
+        if (remaining_ == 0) { return none; }
+        --remaining_;
+        return base_.next();
+    }
+};
+
+/// @class chain_iter iter.hpp <sumty/iter.hpp>
+/// @brief Iterator that yields the items of one iterator, and then those of
+/// another
+///
+/// @details
+/// See @ref iterator_base::chain.
+template <typename A, typename B>
+class chain_iter : public iterator_base<chain_iter<A, B>> {
+  private:
+    A first_;
+    B second_;
+    bool first_done_ = false;
+
+  public:
+    using item_type = item_t<A>;
+
+    static_assert(std::is_same_v<item_type, item_t<B>>,
+                  "chained iterators must have the same item type");
+
+    chain_iter(A first, B second) : first_(std::move(first)), second_(std::move(second)) {}
+
+    option<item_type> next() {
+        if (!first_done_) {
+            auto item = first_.next();
+            if (item.has_value()) { return item; }
+            first_done_ = true;
+        }
+        return second_.next();
+    }
+};
+
+/// @class zip_iter iter.hpp <sumty/iter.hpp>
+/// @brief Iterator that yields pairs of items from two iterators
+///
+/// @details
+/// See @ref iterator_base::zip.
+template <typename A, typename B>
+class zip_iter : public iterator_base<zip_iter<A, B>> {
+  private:
+    A first_;
+    B second_;
+
+  public:
+    using item_type = std::pair<item_t<A>, item_t<B>>;
+
+    zip_iter(A first, B second) : first_(std::move(first)), second_(std::move(second)) {}
+
+    option<item_type> next() {
+        auto lhs = first_.next();
+        if (!lhs.has_value()) { return none; }
+        auto rhs = second_.next();
+        if (!rhs.has_value()) { return none; }
+        return option<item_type>{std::in_place, *std::move(lhs), *std::move(rhs)};
+    }
+};
+
+/// @class flat_map_iter iter.hpp <sumty/iter.hpp>
+/// @brief Iterator that maps each item of another iterator to an iterator
+/// or range, and yields the items of those
+///
+/// @details
+/// If the mapping function returns a range rather than an iterator, it is
+/// converted with @ref from. See @ref iterator_base::flat_map.
+template <typename I, typename F>
+class flat_map_iter : public iterator_base<flat_map_iter<I, F>> {
+  private:
+    template <typename T>
+    static auto into_iter(T&& value) {
+        if constexpr (iterator<std::remove_cvref_t<T>>) {
+            return std::remove_cvref_t<T>(std::forward<T>(value));
+        } else {
+            return iter::from(std::forward<T>(value));
+        }
+    }
+
+    using inner_t =
+        decltype(into_iter(std::declval<std::invoke_result_t<F&, item_t<I>>>()));
+
+    I base_;
+    SUMTY_NO_UNIQ_ADDR F func_;
+    option<inner_t> inner_{};
+
+    // Moves on to the next non-empty inner iterator
+    option<item_t<inner_t>> next_inner() {
+        while (true) {
+            auto outer = base_.next();
+            if (!outer.has_value()) {
+                inner_.reset();
+                return none;
+            }
+            auto& inner = inner_.emplace(into_iter(std::invoke(func_, *std::move(outer))));
+            auto item = inner.next();
+            if (item.has_value()) { return item; }
+        }
+    }
+
+  public:
+    using item_type = item_t<inner_t>;
+
+    flat_map_iter(I base, F func) : base_(std::move(base)), func_(std::move(func)) {}
+
+    option<item_type> next() {
+        if (inner_.has_value()) {
+            // operator-> is get_if, which GCC cannot prove non-null here
+            auto item = (*inner_).next();
+            if (item.has_value()) [[likely]] { return item; }
+        }
+        return next_inner();
+    }
+};
+
+/// @class range_view iter.hpp <sumty/iter.hpp>
+/// @brief `std::ranges::input_range` over an iterator
+///
+/// @details
+/// @ref range_view adapts an @ref iterator for use with range-based for
+/// loops, `std::ranges` algorithms, and `std::views`. Like other input
+/// views, it can only be iterated once, and must not be moved after
+/// `begin()` is called.
+///
+/// See @ref iterator_base::as_range.
+template <typename I>
+class range_view : public std::ranges::view_interface<range_view<I>> {
+  private:
+    I iter_;
+    option<item_t<I>> current_{};
+
+  public:
+    /// @brief Input iterator of a @ref range_view
+    class iterator {
+      private:
+        range_view* view_ = nullptr;
+
+      public:
+        using value_type = std::remove_cvref_t<item_t<I>>;
+        using difference_type = std::ptrdiff_t;
+
+        iterator() noexcept = default;
+
+        explicit iterator(range_view& view) noexcept : view_(std::addressof(view)) {}
+
+        decltype(auto) operator*() const { return *view_->current_; }
+
+        iterator& operator++() {
+            view_->current_ = view_->iter_.next();
+            return *this;
+        }
+
+        void operator++(int) { ++*this; }
+
+        bool operator==([[maybe_unused]] std::default_sentinel_t end) const noexcept {
+            return !view_->current_.has_value();
+        }
+    };
+
+    explicit range_view(I iter) : iter_(std::move(iter)) {}
+
+    iterator begin() {
+        current_ = iter_.next();
+        return iterator(*this);
+    }
+
+    [[nodiscard]] std::default_sentinel_t end() const noexcept { return {}; }
+};
+
+} // namespace sumty::iter
+
+#endif
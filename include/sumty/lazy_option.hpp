@@ -0,0 +1,188 @@
+/* Copyright 2024 Jack A Bernard Jr.
+ *
+ * Licensed under the Apache License, Version 2.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SUMTY_LAZY_OPTION_HPP
+#define SUMTY_LAZY_OPTION_HPP
+
+#include "sumty/detail/utils.hpp"
+#include "sumty/option.hpp"
+#include "sumty/result.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+namespace sumty {
+
+/// @class lazy_option lazy_option.hpp <sumty/lazy_option.hpp>
+/// @brief Thread-safe, lazily initialized @ref option
+///
+/// @details
+/// @ref lazy_option holds an @ref option that starts out empty and is
+/// initialized at most once, by the first caller of @ref get_or_init (or a
+/// successful caller of @ref get_or_try_init). Concurrent callers block until
+/// the initialization finishes, and the initializer runs exactly once.
+///
+/// Once initialized, accessing the value is a single acquire load of a
+/// 32-bit state word, with none of the overhead of `std::call_once`. The
+/// value is stored inline, so unlike a lazily allocated
+/// `std::unique_ptr<T>`, reading it involves no extra indirection.
+///
+/// If the initializer throws, or returns an error from
+/// @ref get_or_try_init, the @ref lazy_option remains empty, and a later
+/// call may try to initialize it again.
+///
+/// ## Example
+/// ```cpp
+/// struct shard {
+///     lazy_option<index> idx{};
+///
+///     const index& get_index() {
+///         return idx.get_or_init([this] { return build_index(*this); });
+///     }
+/// };
+/// ```
+///
+/// @tparam T The value type
+template <typename T>
+class lazy_option {
+  private:
+    enum state : uint32_t { empty, running, ready };
+
+    std::atomic<uint32_t> state_{empty};
+    option<T> value_{};
+
+    // Attempts to become the initializer. Returns `false` if the value is
+    // already initialized. Otherwise, blocks until either this thread owns the
+    // initialization, or another thread has finished it.
+    [[nodiscard]] bool acquire() noexcept {
+        auto cur = state_.load(std::memory_order_acquire);
+        for (;;) {
+            if (cur == ready) { return false; }
+            if (cur == empty) {
+                if (state_.compare_exchange_weak(cur, running, std::memory_order_acquire,
+                                                 std::memory_order_acquire)) {
+                    return true;
+                }
+            } else {
+                state_.wait(running, std::memory_order_acquire);
+                cur = state_.load(std::memory_order_acquire);
+            }
+        }
+    }
+
+    void finish(uint32_t new_state) noexcept {
+        state_.store(new_state, std::memory_order_release);
+        state_.notify_all();
+    }
+
+    // Releases ownership of a failed initialization, so that a waiting
+    // thread can retry.
+    // NOLINTNEXTLINE(cppcoreguidelines-special-member-functions)
+    struct release_on_unwind {
+        lazy_option* self;
+        ~release_on_unwind() {
+            if (self != nullptr) { self->finish(empty); }
+        }
+    };
+
+  public:
+    using value_type = T;
+
+    /// @brief Constructs an uninitialized @ref lazy_option
+    constexpr lazy_option() noexcept = default;
+
+    lazy_option(const lazy_option&) = delete;
+
+    lazy_option& operator=(const lazy_option&) = delete;
+
+    ~lazy_option() noexcept = default;
+
+    /// @brief Checks if the value has been initialized
+    [[nodiscard]] bool is_initialized() const noexcept {
+        return state_.load(std::memory_order_acquire) == ready;
+    }
+
+    /// @brief Gets the value if it has been initialized, without blocking
+    [[nodiscard]] option<T&> get() noexcept {
+        if (!is_initialized()) { return none; }
+        return &*value_;
+    }
+
+    /// @brief Gets the value if it has been initialized, without blocking
+    [[nodiscard]] option<const T&> get() const noexcept {
+        if (!is_initialized()) { return none; }
+        return &*value_;
+    }
+
+    /// @brief Gets the value, initializing it with `func` if needed
+    ///
+    /// @details
+    /// If the value is uninitialized, `func` is called with no arguments, and
+    /// the value is constructed from its return value. If multiple threads
+    /// call this function concurrently, `func` is only called by one of them,
+    /// and the others block until the value is initialized.
+    ///
+    /// If `func` throws, the exception is propagated and the
+    /// @ref lazy_option remains uninitialized.
+    template <typename F>
+    T& get_or_init(F&& func) {
+        if (acquire()) {
+            release_on_unwind guard{this};
+            value_.emplace(std::invoke(std::forward<F>(func)));
+            guard.self = nullptr;
+            finish(ready);
+        }
+        return *value_;
+    }
+
+    /// @brief Gets the value, initializing it with a fallible function if
+    /// needed
+    ///
+    /// @details
+    /// `func` must return a @ref result. If the value is uninitialized,
+    /// `func` is called with no arguments. If it returns a value, the
+    /// @ref lazy_option is initialized with that value, and a reference to
+    /// it is returned. If it returns an error, the @ref lazy_option remains
+    /// uninitialized, so that a later call may retry, and the error is
+    /// returned.
+    ///
+    /// If multiple threads call this function concurrently, only one of them
+    /// calls `func` at a time, and the others block until it is done.
+    template <typename F>
+#ifndef DOXYGEN
+        requires(detail::is_result_v<std::remove_cvref_t<std::invoke_result_t<F>>>)
+#endif
+    result<T&, typename std::remove_cvref_t<std::invoke_result_t<F>>::error_type>
+        get_or_try_init(F&& func) {
+        using ret_t =
+            result<T&, typename std::remove_cvref_t<std::invoke_result_t<F>>::error_type>;
+        if (acquire()) {
+            release_on_unwind guard{this};
+            auto res = std::invoke(std::forward<F>(func));
+            if (!res.has_value()) { return ret_t{in_place_error, std::move(res).error()}; }
+            value_.emplace(*std::move(res));
+            guard.self = nullptr;
+            finish(ready);
+        }
+        return ret_t{std::in_place, *value_};
+    }
+};
+
+} // namespace sumty
+
+#endif
@@ -0,0 +1,441 @@
+/* Copyright 2024 Jack A Bernard Jr.
+ *
+ * Licensed under the Apache License, Version 2.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SUMTY_MPMC_QUEUE_HPP
+#define SUMTY_MPMC_QUEUE_HPP
+
+#include "sumty/detail/utils.hpp"
+#include "sumty/option.hpp"
+#include "sumty/utils.hpp"
+#include "sumty/variant.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace sumty {
+
+namespace detail {
+
+// The type actually stored in a queue slot for an alternative. References
+// are stored as pointers, and void alternatives store nothing.
+template <typename T>
+struct queue_slot_type {
+    using type = T;
+};
+
+template <typename T>
+struct queue_slot_type<T&> {
+    using type = T*;
+};
+
+template <>
+struct queue_slot_type<void> {
+    using type = char;
+};
+
+template <typename T>
+using queue_slot_type_t = typename queue_slot_type<T>::type;
+
+template <typename T>
+static inline constexpr bool is_queue_movable_v =
+    std::is_void_v<T> || std::is_lvalue_reference_v<T> ||
+    std::is_nothrow_move_constructible_v<T>;
+
+} // namespace detail
+
+template <typename V>
+class mpmc_queue;
+
+/// @class mpmc_queue mpmc_queue.hpp <sumty/mpmc_queue.hpp>
+/// @brief Bounded, lock-free, multi-producer multi-consumer queue of
+/// @ref variant messages
+///
+/// @details
+/// @ref mpmc_queue is a ring buffer of slots in the style of Dmitry Vyukov's
+/// bounded MPMC queue, where every slot carries a sequence number that tells
+/// producers and consumers whether the slot is free or full. Producers and
+/// consumers each claim a slot with a single CAS on a shared counter, and
+/// never wait on each other unless the queue is full or empty.
+///
+/// Rather than storing whole @ref variant objects, each slot holds raw
+/// storage sized and aligned for the largest alternative, along with a
+/// discriminant. A push moves the alternative directly into the slot, and a
+/// pop moves it directly into the returned @ref option, so each message is
+/// moved exactly once in each direction. All slots are allocated by the
+/// constructor, and the queue never allocates after that.
+///
+/// The capacity is rounded up to a power of two. Alternatives must be
+/// nothrow move constructible, since a claimed slot cannot be released.
+///
+/// ## Example
+/// ```cpp
+/// struct tick { double price; };
+/// struct shutdown {};
+///
+/// mpmc_queue<variant<tick, shutdown>> queue(1024);
+///
+/// // producers
+/// queue.try_push(tick{101.25});
+///
+/// // consumers
+/// while (auto msg = queue.try_pop()) {
+///     msg->visit(overload(
+///         [](tick& t) { /* ... */ },
+///         [](shutdown) { /* ... */ }
+///     ));
+/// }
+/// ```
+///
+/// @tparam T The alternative types of the queued @ref variant
+template <typename... T>
+class mpmc_queue<variant<T...>> {
+  private:
+    static_assert((detail::is_queue_movable_v<T> && ...),
+                  "mpmc_queue requires nothrow move constructible alternatives");
+
+    static constexpr size_t cache_line = 64;
+
+    static constexpr size_t storage_size =
+        std::max({sizeof(detail::queue_slot_type_t<T>)...});
+
+    static constexpr size_t storage_align =
+        std::max({alignof(detail::queue_slot_type_t<T>)...});
+
+    using discrim_t = detail::discriminant_t<sizeof...(T)>;
+
+    struct slot {
+        std::atomic<size_t> seq;
+        discrim_t discrim;
+        alignas(storage_align) std::array<std::byte, storage_size> data;
+    };
+
+    template <size_t I>
+    static void construct_alt(slot& dst, variant<T...>& src) noexcept {
+        using alt_t = detail::select_t<I, T...>;
+        if constexpr (std::is_lvalue_reference_v<alt_t>) {
+            new (dst.data.data()) detail::queue_slot_type_t<alt_t>(&src[index<I>]);
+        } else if constexpr (!std::is_void_v<alt_t>) {
+            new (dst.data.data()) alt_t(std::move(src[index<I>]));
+        }
+        dst.discrim = static_cast<discrim_t>(I);
+    }
+
+    template <size_t I>
+    [[nodiscard]] static option<variant<T...>> take_alt(slot& src) noexcept {
+        using alt_t = detail::select_t<I, T...>;
+        if constexpr (std::is_void_v<alt_t>) {
+            return option<variant<T...>>(std::in_place, std::in_place_index<I>);
+        } else {
+            using stored_t = detail::queue_slot_type_t<alt_t>;
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+            auto* obj = std::launder(reinterpret_cast<stored_t*>(src.data.data()));
+            if constexpr (std::is_lvalue_reference_v<alt_t>) {
+                return option<variant<T...>>(std::in_place, std::in_place_index<I>, **obj);
+            } else {
+                // destroy the moved-from object after the return value has
+                // been constructed, without a second move of the payload
+                // NOLINTNEXTLINE(cppcoreguidelines-special-member-functions)
+                struct destroy_guard {
+                    stored_t* obj;
+                    ~destroy_guard() noexcept { obj->~stored_t(); }
+                } guard{obj};
+                return option<variant<T...>>(std::in_place, std::in_place_index<I>,
+                                             std::move(*obj));
+            }
+        }
+    }
+
+    // Moves the alternative out of the slot straight into `*out`. When `*out`
+    // is a variant lvalue, the alternative is emplaced into it, so the payload
+    // is moved exactly once. Other outputs (such as insert iterators) are
+    // assigned a variant constructed from the slot.
+    template <size_t I, typename O>
+    static void take_alt_into(slot& src, O& out) {
+        using alt_t = detail::select_t<I, T...>;
+        using out_ref_t = decltype(*out);
+        constexpr bool direct = std::is_same_v<out_ref_t, variant<T...>&>;
+        if constexpr (std::is_void_v<alt_t>) {
+            if constexpr (direct) {
+                (*out).template emplace<I>();
+            } else {
+                *out = variant<T...>(std::in_place_index<I>);
+            }
+        } else {
+            using stored_t = detail::queue_slot_type_t<alt_t>;
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+            auto* obj = std::launder(reinterpret_cast<stored_t*>(src.data.data()));
+            if constexpr (std::is_lvalue_reference_v<alt_t>) {
+                if constexpr (direct) {
+                    (*out).template emplace<I>(**obj);
+                } else {
+                    *out = variant<T...>(std::in_place_index<I>, **obj);
+                }
+            } else {
+                // NOLINTNEXTLINE(cppcoreguidelines-special-member-functions)
+                struct destroy_guard {
+                    stored_t* obj;
+                    ~destroy_guard() noexcept { obj->~stored_t(); }
+                } guard{obj};
+                if constexpr (direct) {
+                    (*out).template emplace<I>(std::move(*obj));
+                } else {
+                    *out = variant<T...>(std::in_place_index<I>, std::move(*obj));
+                }
+            }
+        }
+    }
+
+    template <size_t... I>
+    static void construct(slot& dst,
+                          variant<T...>& src,
+                          [[maybe_unused]] std::index_sequence<I...> seq) noexcept {
+        static constexpr std::array<void (*)(slot&, variant<T...>&), sizeof...(T)> table{
+            &construct_alt<I>...};
+        table[src.index()](dst, src);
+    }
+
+    template <size_t... I>
+    [[nodiscard]] static option<variant<T...>> take(
+        slot& src,
+        [[maybe_unused]] std::index_sequence<I...> seq) noexcept {
+        static constexpr std::array<option<variant<T...>> (*)(slot&), sizeof...(T)> table{
+            &take_alt<I>...};
+        return table[src.discrim](src);
+    }
+
+    template <typename O, size_t... I>
+    static void take_into(slot& src,
+                          O& out,
+                          [[maybe_unused]] std::index_sequence<I...> seq) {
+        static constexpr std::array<void (*)(slot&, O&), sizeof...(T)> table{
+            &take_alt_into<I, O>...};
+        table[src.discrim](src, out);
+    }
+
+    alignas(cache_line) std::atomic<size_t> enqueue_pos_{0};
+    alignas(cache_line) std::atomic<size_t> dequeue_pos_{0};
+    alignas(cache_line) size_t mask_;
+    std::unique_ptr<slot[]> slots_; // NOLINT(cppcoreguidelines-avoid-c-arrays)
+
+    // Claims a slot for writing, or returns null if the queue is full.
+    [[nodiscard]] slot* claim_push() noexcept {
+        auto pos = enqueue_pos_.load(std::memory_order_relaxed);
+        for (;;) {
+            auto& cell = slots_[pos & mask_];
+            const auto seq = cell.seq.load(std::memory_order_acquire);
+            const auto diff = static_cast<std::ptrdiff_t>(seq - pos);
+            if (diff == 0) {
+                if (enqueue_pos_.compare_exchange_weak(pos, pos + 1,
+                                                       std::memory_order_relaxed)) {
+                    return &cell;
+                }
+            } else if (diff < 0) {
+                return nullptr;
+            } else {
+                pos = enqueue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    void publish_push(slot& cell) noexcept {
+        // the slot was claimed at position `seq`, and is now full
+        cell.seq.store(cell.seq.load(std::memory_order_relaxed) + 1,
+                       std::memory_order_release);
+    }
+
+    // Claims up to `max_count` consecutive full slots for reading. Returns
+    // the first claimed position and the number of slots claimed.
+    [[nodiscard]] std::pair<size_t, size_t> claim_pop(size_t max_count) noexcept {
+        auto pos = dequeue_pos_.load(std::memory_order_relaxed);
+        if (max_count == 0) { return {pos, 0}; }
+        for (;;) {
+            size_t count = 0;
+            while (count < max_count) {
+                const auto& cell = slots_[(pos + count) & mask_];
+                const auto seq = cell.seq.load(std::memory_order_acquire);
+                if (seq != pos + count + 1) { break; }
+                ++count;
+            }
+            if (count == 0) {
+                const auto& cell = slots_[pos & mask_];
+                const auto seq = cell.seq.load(std::memory_order_acquire);
+                const auto diff = static_cast<std::ptrdiff_t>(seq - (pos + 1));
+                if (diff < 0) { return {pos, 0}; }
+                pos = dequeue_pos_.load(std::memory_order_relaxed);
+                continue;
+            }
+            if (dequeue_pos_.compare_exchange_weak(pos, pos + count,
+                                                   std::memory_order_relaxed)) {
+                return {pos, count};
+            }
+        }
+    }
+
+    [[nodiscard]] option<variant<T...>> take_at(size_t pos) noexcept {
+        // marks the slot as free for the next lap once the message is taken
+        // NOLINTNEXTLINE(cppcoreguidelines-special-member-functions)
+        struct release_guard {
+            slot& cell;
+            size_t next_seq;
+            ~release_guard() noexcept {
+                cell.seq.store(next_seq, std::memory_order_release);
+            }
+        } guard{slots_[pos & mask_], pos + mask_ + 1};
+        return take(guard.cell, std::index_sequence_for<T...>{});
+    }
+
+    template <typename O>
+    void take_at_into(size_t pos, O& out) {
+        // NOLINTNEXTLINE(cppcoreguidelines-special-member-functions)
+        struct release_guard {
+            slot& cell;
+            size_t next_seq;
+            ~release_guard() noexcept {
+                cell.seq.store(next_seq, std::memory_order_release);
+            }
+        } guard{slots_[pos & mask_], pos + mask_ + 1};
+        take_into(guard.cell, out, std::index_sequence_for<T...>{});
+    }
+
+  public:
+    using value_type = variant<T...>;
+
+    /// @brief Constructs an empty @ref mpmc_queue
+    ///
+    /// @param capacity The minimum number of messages the queue can hold.
+    /// The actual capacity is rounded up to a power of two, and is at least
+    /// 2.
+    explicit mpmc_queue(size_t capacity)
+        : mask_(std::bit_ceil(std::max(capacity, size_t{2})) - 1),
+          // NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays)
+          slots_(std::make_unique<slot[]>(mask_ + 1)) {
+        for (size_t i = 0; i <= mask_; ++i) {
+            slots_[i].seq.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    mpmc_queue(const mpmc_queue&) = delete;
+
+    mpmc_queue& operator=(const mpmc_queue&) = delete;
+
+    /// @brief Destroys any messages remaining in the queue
+    ~mpmc_queue() noexcept {
+        while (try_pop().has_value()) {}
+    }
+
+    /// @brief Gets the maximum number of messages the queue can hold
+    [[nodiscard]] size_t capacity() const noexcept { return mask_ + 1; }
+
+    /// @brief Attempts to push a message onto the queue
+    ///
+    /// @details
+    /// If the queue is full, `msg` is left untouched and `false` is
+    /// returned.
+    bool try_push(variant<T...>&& msg) noexcept {
+        auto* cell = claim_push();
+        if (cell == nullptr) { return false; }
+        construct(*cell, msg, std::index_sequence_for<T...>{});
+        publish_push(*cell);
+        return true;
+    }
+
+    /// @brief Attempts to push a copy of a message onto the queue
+    ///
+    /// @details
+    /// The message is copied before a slot is claimed, so a throwing copy
+    /// leaves the queue unchanged.
+    bool try_push(const variant<T...>& msg) {
+        auto copy = msg;
+        return try_push(std::move(copy));
+    }
+
+    /// @brief Attempts to push a message constructed in place onto the queue
+    ///
+    /// @details
+    /// The alternative at index `IDX` is constructed directly in the claimed
+    /// slot, which requires the construction not to throw.
+    template <size_t IDX, typename... Args>
+#ifndef DOXYGEN
+        requires(std::is_lvalue_reference_v<detail::select_t<IDX, T...>>
+                     ? sizeof...(Args) == 1
+                     : std::is_nothrow_constructible_v<
+                           detail::queue_slot_type_t<detail::select_t<IDX, T...>>,
+                           Args&&...>)
+#endif
+    bool try_emplace([[maybe_unused]] std::in_place_index_t<IDX> inplace,
+                     Args&&... args) noexcept {
+        using alt_t = detail::select_t<IDX, T...>;
+        auto* cell = claim_push();
+        if (cell == nullptr) { return false; }
+        if constexpr (std::is_lvalue_reference_v<alt_t>) {
+            using ptr_t = detail::queue_slot_type_t<alt_t>;
+            new (cell->data.data()) ptr_t(std::addressof(args)...);
+        } else if constexpr (!std::is_void_v<alt_t>) {
+            new (cell->data.data()) alt_t(std::forward<Args>(args)...);
+        }
+        cell->discrim = static_cast<discrim_t>(IDX);
+        publish_push(*cell);
+        return true;
+    }
+
+    /// @brief Attempts to pop a message from the queue
+    ///
+    /// @return The message, or an empty @ref option if the queue is empty
+    [[nodiscard]] option<variant<T...>> try_pop() noexcept {
+        const auto [pos, count] = claim_pop(1);
+        if (count == 0) { return none; }
+        return take_at(pos);
+    }
+
+    /// @brief Attempts to pop up to `max_count` messages from the queue
+    ///
+    /// @details
+    /// All messages that are ready at the head of the queue, up to
+    /// `max_count`, are claimed with a single CAS, and then moved to `out` in
+    /// order. If `*out` is a @ref variant lvalue, each message is moved out of
+    /// its slot directly into it. Otherwise, `*out` is assigned a @ref variant
+    /// constructed from the slot. If an assignment throws, the remaining
+    /// claimed messages are discarded before the exception is rethrown.
+    ///
+    /// @return The number of messages popped
+    template <typename O>
+    size_t try_pop_batch(O out, size_t max_count) {
+        const auto [pos, count] = claim_pop(max_count);
+        size_t i = 0;
+        try {
+            for (; i < count; ++i) {
+                take_at_into(pos + i, out);
+                ++out;
+            }
+        } catch (...) {
+            // the remaining claimed slots must still be released
+            for (++i; i < count; ++i) { static_cast<void>(take_at(pos + i)); }
+            throw;
+        }
+        return count;
+    }
+};
+
+} // namespace sumty
+
+#endif
@@ -0,0 +1,258 @@
+/* Copyright 2024 Jack A Bernard Jr.
+ *
+ * Licensed under the Apache License, Version 2.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SUMTY_OFFSET_REF_HPP
+#define SUMTY_OFFSET_REF_HPP
+
+#include "sumty/detail/traits.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <type_traits>
+
+namespace sumty {
+
+/// @class offset_ref offset_ref.hpp <sumty/offset_ref.hpp>
+/// @brief Self-relative reference
+///
+/// @details
+/// @ref offset_ref is a rebindable reference, like `std::reference_wrapper`,
+/// that stores the distance from its own address to the referenced object
+/// instead of the object's address. As long as an @ref offset_ref and the
+/// object it refers to are in the same memory segment, the @ref offset_ref
+/// remains valid when the segment is mapped at a different address, such as
+/// a shared memory segment `mmap`ed by several processes, or a file that is
+/// mapped back in after being written out.
+///
+/// Copying or assigning an @ref offset_ref recomputes the distance for the
+/// new location, so the copy refers to the same object.
+///
+/// `option<offset_ref<T>>` stores `none` in an otherwise unused offset
+/// value, so it is the same size as @ref offset_ref.
+///
+/// ## Example
+/// ```cpp
+/// struct node {
+///     int value;
+///     option<offset_ref<node>> next;
+/// };
+///
+/// auto* nodes = static_cast<node*>(mmap(/* ... */));
+/// std::construct_at(&nodes[1], 2, none);
+/// std::construct_at(&nodes[0], 1, nodes[1]);
+///
+/// static_assert(sizeof(option<offset_ref<node>>) == sizeof(std::ptrdiff_t));
+/// assert(nodes[0].next->get().value == 2);
+/// ```
+///
+/// @tparam T The type of the referenced object
+template <typename T>
+class offset_ref {
+  private:
+    static constexpr std::ptrdiff_t niche_offset =
+        std::numeric_limits<std::ptrdiff_t>::min();
+
+    std::ptrdiff_t offset_;
+
+    explicit offset_ref([[maybe_unused]] detail::niche_t tag) noexcept
+        : offset_(niche_offset) {}
+
+    [[nodiscard]] std::uintptr_t addr() const noexcept {
+        return reinterpret_cast<std::uintptr_t>(this);
+    }
+
+    void bind(const volatile void* target) noexcept {
+        offset_ = static_cast<std::ptrdiff_t>(reinterpret_cast<std::uintptr_t>(target) -
+                                              addr());
+    }
+
+    void bind(const offset_ref& other) noexcept {
+        if (other.offset_ == niche_offset) {
+            offset_ = niche_offset;
+        } else {
+            bind(std::addressof(other.get()));
+        }
+    }
+
+    friend struct detail::niche_traits<offset_ref>;
+
+  public:
+    using type = T;
+
+    /// @brief Constructs an @ref offset_ref that refers to `target`
+    template <typename U>
+#ifndef DOXYGEN
+        requires(std::is_convertible_v<U*, T*>)
+#endif
+    // NOLINTNEXTLINE(hicpp-explicit-conversions)
+    offset_ref(U& target) noexcept : offset_(0) {
+        bind(static_cast<T*>(std::addressof(target)));
+    }
+
+    /// @brief Copy constructor
+    ///
+    /// @details
+    /// The new @ref offset_ref refers to the same object as `other`.
+    offset_ref(const offset_ref& other) noexcept : offset_(0) { bind(other); }
+
+    /// @brief Copy assignment operator
+    ///
+    /// @details
+    /// Rebinds this @ref offset_ref to the object `rhs` refers to.
+    offset_ref& operator=(const offset_ref& rhs) noexcept {
+        bind(rhs);
+        return *this;
+    }
+
+    ~offset_ref() noexcept = default;
+
+    /// @brief Gets a reference to the referenced object
+    [[nodiscard]] T& get() const noexcept {
+        // NOLINTNEXTLINE(performance-no-int-to-ptr)
+        return *reinterpret_cast<T*>(addr() + static_cast<std::uintptr_t>(offset_));
+    }
+
+    /// @brief Gets a reference to the referenced object
+    // NOLINTNEXTLINE(hicpp-explicit-conversions)
+    operator T&() const noexcept { return get(); }
+
+    /// @brief Gets a reference to the referenced object
+    [[nodiscard]] T& operator*() const noexcept { return get(); }
+
+    /// @brief Accesses members of the referenced object
+    T* operator->() const noexcept { return std::addressof(get()); }
+};
+
+/// @class rel32_ref offset_ref.hpp <sumty/offset_ref.hpp>
+/// @brief Compressed reference into an arena
+///
+/// @details
+/// @ref rel32_ref is a rebindable reference that stores the 32-bit offset of
+/// the referenced object from the base address of an arena, instead of the
+/// object's address. In pointer-heavy structures allocated from an arena of
+/// less than 4 GiB, this halves the size of each link compared to a
+/// pointer. Because only offsets are stored, the arena may also be mapped at
+/// a different address, such as in another process.
+///
+/// The arena is identified by `Base`, which must provide a static function
+/// `base()` that returns a pointer to the start of the arena. The referenced
+/// object must lie within the first `UINT32_MAX` bytes of the arena.
+///
+/// Unlike @ref offset_ref, @ref rel32_ref is trivially copyable.
+/// `option<rel32_ref<T, Base>>` stores `none` in the unused offset value
+/// `UINT32_MAX`, so it is the same size as @ref rel32_ref.
+///
+/// ## Example
+/// ```cpp
+/// struct arena {
+///     static inline std::byte* mapping = nullptr;
+///     static std::byte* base() noexcept { return mapping; }
+/// };
+///
+/// struct node {
+///     int value;
+///     option<rel32_ref<node, arena>> next;
+/// };
+///
+/// static_assert(sizeof(node) == 8);
+/// ```
+///
+/// @tparam T The type of the referenced object
+/// @tparam Base The type that provides the base address of the arena
+template <typename T, typename Base>
+class rel32_ref {
+  private:
+    static constexpr uint32_t niche_offset = std::numeric_limits<uint32_t>::max();
+
+    uint32_t offset_;
+
+    explicit rel32_ref([[maybe_unused]] detail::niche_t tag) noexcept
+        : offset_(niche_offset) {}
+
+    [[nodiscard]] static std::uintptr_t base_addr() noexcept {
+        static_assert(std::is_pointer_v<decltype(Base::base())>,
+                      "Base::base() must return a pointer to the arena");
+        return reinterpret_cast<std::uintptr_t>(Base::base());
+    }
+
+    friend struct detail::niche_traits<rel32_ref>;
+
+  public:
+    using type = T;
+    using base_type = Base;
+
+    /// @brief Constructs a @ref rel32_ref that refers to `target`
+    template <typename U>
+#ifndef DOXYGEN
+        requires(std::is_convertible_v<U*, T*>)
+#endif
+    // NOLINTNEXTLINE(hicpp-explicit-conversions)
+    rel32_ref(U& target) noexcept
+        : offset_(static_cast<uint32_t>(
+              reinterpret_cast<std::uintptr_t>(static_cast<T*>(std::addressof(target))) -
+              base_addr())) {
+    }
+
+    /// @brief Gets the offset of the referenced object from the arena base
+    [[nodiscard]] uint32_t offset() const noexcept { return offset_; }
+
+    /// @brief Gets a reference to the referenced object
+    [[nodiscard]] T& get() const noexcept {
+        // NOLINTNEXTLINE(performance-no-int-to-ptr)
+        return *reinterpret_cast<T*>(base_addr() + offset_);
+    }
+
+    /// @brief Gets a reference to the referenced object
+    // NOLINTNEXTLINE(hicpp-explicit-conversions)
+    operator T&() const noexcept { return get(); }
+
+    /// @brief Gets a reference to the referenced object
+    [[nodiscard]] T& operator*() const noexcept { return get(); }
+
+    /// @brief Accesses members of the referenced object
+    T* operator->() const noexcept { return std::addressof(get()); }
+};
+
+namespace detail {
+
+template <typename T>
+struct niche_traits<offset_ref<T>> {
+    static inline constexpr bool has_niche = true;
+
+    static offset_ref<T> make_niche() noexcept { return offset_ref<T>(niche); }
+
+    static bool is_niche(const offset_ref<T>& value) noexcept {
+        return value.offset_ == offset_ref<T>::niche_offset;
+    }
+};
+
+template <typename T, typename Base>
+struct niche_traits<rel32_ref<T, Base>> {
+    static inline constexpr bool has_niche = true;
+
+    static rel32_ref<T, Base> make_niche() noexcept { return rel32_ref<T, Base>(niche); }
+
+    static bool is_niche(const rel32_ref<T, Base>& value) noexcept {
+        return value.offset_ == rel32_ref<T, Base>::niche_offset;
+    }
+};
+
+} // namespace detail
+
+} // namespace sumty
+
+#endif
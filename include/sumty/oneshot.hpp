@@ -0,0 +1,258 @@
+/* Copyright 2024 Jack A Bernard Jr.
+ *
+ * Licensed under the Apache License, Version 2.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SUMTY_ONESHOT_HPP
+#define SUMTY_ONESHOT_HPP
+
+#include "sumty/exceptions.hpp"
+#include "sumty/option.hpp"
+#include "sumty/result.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <system_error>
+#include <utility>
+
+namespace sumty {
+
+namespace detail {
+
+// Shared implementation of oneshot and shared_oneshot. The result is stored
+// inline, and its publication is tracked by a 32-bit state word, which is the
+// size std::atomic::wait can map directly onto a futex.
+template <typename T, typename E>
+class oneshot_cell {
+  public:
+    enum state : uint32_t { empty, writing, ready, taken };
+
+  private:
+    std::atomic<uint32_t> state_{empty};
+    option<result<T, E>> value_{};
+
+  public:
+    template <typename U>
+    bool set(U&& res) {
+        uint32_t expected = empty;
+        if (!state_.compare_exchange_strong(expected, writing, std::memory_order_acquire,
+                                            std::memory_order_relaxed)) {
+            return false;
+        }
+        // NOLINTNEXTLINE(cppcoreguidelines-special-member-functions)
+        struct rollback {
+            std::atomic<uint32_t>* state;
+            ~rollback() {
+                if (state != nullptr) { state->store(empty, std::memory_order_relaxed); }
+            }
+        } guard{&state_};
+        value_.emplace(std::forward<U>(res));
+        guard.state = nullptr;
+        state_.store(ready, std::memory_order_release);
+        state_.notify_all();
+        return true;
+    }
+
+    [[nodiscard]] uint32_t load() const noexcept {
+        return state_.load(std::memory_order_acquire);
+    }
+
+    // Blocks until the state is `ready` or `taken`, and returns it.
+    uint32_t wait() const noexcept {
+        auto cur = state_.load(std::memory_order_acquire);
+        while (cur == empty || cur == writing) {
+            state_.wait(cur, std::memory_order_acquire);
+            cur = state_.load(std::memory_order_acquire);
+        }
+        return cur;
+    }
+
+    [[nodiscard]] const result<T, E>& get() const noexcept { return *value_; }
+
+    [[nodiscard]] result<T, E> take() {
+        state_.store(taken, std::memory_order_relaxed);
+        return *std::move(value_);
+    }
+};
+
+} // namespace detail
+
+/// @class oneshot oneshot.hpp <sumty/oneshot.hpp>
+/// @brief Single-use channel that delivers one @ref result to one consumer
+///
+/// @details
+/// @ref oneshot is a lightweight replacement for a `std::promise` and
+/// `std::future` pair. A producer calls @ref set once, and a consumer calls
+/// @ref wait to block until the @ref result is available and move it out.
+///
+/// Unlike `std::promise`, @ref oneshot has no separately allocated shared
+/// state: the @ref result is stored inline, so a @ref oneshot that is a
+/// member of a request object, or that lives on the stack of a thread that
+/// outlives the producer, requires no allocation at all. Waiting uses
+/// `std::atomic::wait`, which is a futex wait on Linux, instead of a mutex
+/// and condition variable. Errors are delivered as the error value of the
+/// @ref result rather than as an exception.
+///
+/// @ref oneshot is neither copyable nor movable, and must outlive both the
+/// producer and the consumer. For multiple consumers, see
+/// @ref shared_oneshot.
+///
+/// ## Example
+/// ```cpp
+/// oneshot<int> reply{};
+///
+/// std::thread worker([&reply] {
+///     reply.set(42);
+/// });
+///
+/// result<int> res = reply.wait();
+/// assert(res == 42);
+/// worker.join();
+/// ```
+///
+/// @tparam T The value type of the delivered @ref result
+/// @tparam E The error type of the delivered @ref result
+template <typename T, typename E = std::error_code>
+class oneshot {
+  private:
+    using cell_t = detail::oneshot_cell<T, E>;
+
+    cell_t cell_;
+
+  public:
+    using value_type = result<T, E>;
+
+    /// @brief Constructs an empty @ref oneshot
+    oneshot() noexcept = default;
+
+    oneshot(const oneshot&) = delete;
+
+    oneshot& operator=(const oneshot&) = delete;
+
+    ~oneshot() noexcept = default;
+
+    /// @brief Delivers a @ref result to the consumer
+    ///
+    /// @details
+    /// `res` may be a @ref result, or anything a @ref result can be
+    /// constructed from, such as a value or an @ref error_t. Only the first
+    /// call has any effect. If constructing the @ref result throws, the
+    /// @ref oneshot remains empty.
+    ///
+    /// @return `true` if the @ref result was delivered, or `false` if a
+    /// @ref result was already delivered.
+    template <typename U>
+    bool set(U&& res) {
+        return cell_.set(std::forward<U>(res));
+    }
+
+    /// @brief Checks if a @ref result has been delivered and not yet taken
+    [[nodiscard]] bool ready() const noexcept { return cell_.load() == cell_t::ready; }
+
+    /// @brief Blocks until a @ref result is delivered, and moves it out
+    ///
+    /// @throws bad_option_access Thrown if the @ref result was already taken
+    /// by a previous call to @ref wait or @ref try_take.
+    [[nodiscard]] result<T, E> wait() {
+        if (cell_.wait() == cell_t::taken) [[unlikely]] {
+            detail::throw_bad_option_access();
+        }
+        return cell_.take();
+    }
+
+    /// @brief Moves out the @ref result if it has been delivered, without
+    /// blocking
+    [[nodiscard]] option<result<T, E>> try_take() {
+        if (!ready()) { return none; }
+        return option<result<T, E>>(std::in_place, cell_.take());
+    }
+};
+
+/// @class shared_oneshot oneshot.hpp <sumty/oneshot.hpp>
+/// @brief Single-use channel that delivers one @ref result to any number of
+/// consumers
+///
+/// @details
+/// @ref shared_oneshot is like @ref oneshot, except that @ref wait returns a
+/// const reference to the delivered @ref result, so any number of threads
+/// may wait on and read the same @ref result. Once delivered, the
+/// @ref result is immutable and lives as long as the @ref shared_oneshot.
+///
+/// ## Example
+/// ```cpp
+/// shared_oneshot<config, std::string> loaded{};
+///
+/// // loader
+/// loaded.set(load_config());
+///
+/// // any number of readers
+/// const result<config, std::string>& cfg = loaded.wait();
+/// ```
+///
+/// @tparam T The value type of the delivered @ref result
+/// @tparam E The error type of the delivered @ref result
+template <typename T, typename E = std::error_code>
+class shared_oneshot {
+  private:
+    using cell_t = detail::oneshot_cell<T, E>;
+
+    cell_t cell_;
+
+  public:
+    using value_type = result<T, E>;
+
+    /// @brief Constructs an empty @ref shared_oneshot
+    shared_oneshot() noexcept = default;
+
+    shared_oneshot(const shared_oneshot&) = delete;
+
+    shared_oneshot& operator=(const shared_oneshot&) = delete;
+
+    ~shared_oneshot() noexcept = default;
+
+    /// @brief Delivers a @ref result to all consumers
+    ///
+    /// @details
+    /// `res` may be a @ref result, or anything a @ref result can be
+    /// constructed from, such as a value or an @ref error_t. Only the first
+    /// call has any effect. If constructing the @ref result throws, the
+    /// @ref shared_oneshot remains empty.
+    ///
+    /// @return `true` if the @ref result was delivered, or `false` if a
+    /// @ref result was already delivered.
+    template <typename U>
+    bool set(U&& res) {
+        return cell_.set(std::forward<U>(res));
+    }
+
+    /// @brief Checks if a @ref result has been delivered
+    [[nodiscard]] bool ready() const noexcept { return cell_.load() == cell_t::ready; }
+
+    /// @brief Blocks until a @ref result is delivered, and returns a
+    /// reference to it
+    [[nodiscard]] const result<T, E>& wait() const noexcept {
+        static_cast<void>(cell_.wait());
+        return cell_.get();
+    }
+
+    /// @brief Gets a reference to the @ref result if it has been delivered,
+    /// without blocking
+    [[nodiscard]] option<const result<T, E>&> try_get() const noexcept {
+        if (!ready()) { return none; }
+        return option<const result<T, E>&>(&cell_.get());
+    }
+};
+
+} // namespace sumty
+
+#endif
@@ -17,6 +17,7 @@
 #define SUMTY_OPTION_HPP
 
 #include "sumty/detail/fwd.hpp"    // IWYU pragma: export
+#include "sumty/detail/hash.hpp"
 #include "sumty/detail/traits.hpp" // IWYU pragma: export
 #include "sumty/detail/utils.hpp"
 #include "sumty/exceptions.hpp"
@@ -1050,8 +1051,10 @@ class option {
     ///
     /// @throws bad_option_access Thrown if the @ref option is `none`.
     [[nodiscard]] constexpr reference value() & {
-        if (opt_.index() == 0) { throw bad_option_access(); }
-        return opt_[index<1>];
+        if (opt_.index() != 0) [[likely]] {
+            return opt_[index<1>];
+        }
+        detail::throw_bad_option_access();
     }
 
     /// @brief Accesses the value contained in the @ref option.
@@ -1070,8 +1073,10 @@ class option {
     ///
     /// @throws bad_option_access Thrown if the @ref option is `none`.
     [[nodiscard]] constexpr const_reference value() const& {
-        if (opt_.index() == 0) { throw bad_option_access(); }
-        return opt_[index<1>];
+        if (opt_.index() != 0) [[likely]] {
+            return opt_[index<1>];
+        }
+        detail::throw_bad_option_access();
     }
 
     /// @brief Accesses the value contained in the @ref option.
@@ -1090,8 +1095,10 @@ class option {
     ///
     /// @throws bad_option_access Thrown if the @ref option is `none`.
     [[nodiscard]] constexpr rvalue_reference value() && {
-        if (opt_.index() == 0) { throw bad_option_access(); }
-        return std::move(opt_)[index<1>];
+        if (opt_.index() != 0) [[likely]] {
+            return std::move(opt_)[index<1>];
+        }
+        detail::throw_bad_option_access();
     }
 
     /// @brief Accesses the value contained in the @ref option.
@@ -1110,8 +1117,10 @@ class option {
     ///
     /// @throws bad_option_access Thrown if the @ref option is `none`.
     [[nodiscard]] constexpr rvalue_reference value() const&& {
-        if (opt_.index() == 0) { throw bad_option_access(); }
-        return std::move(opt_)[index<1>];
+        if (opt_.index() != 0) [[likely]] {
+            return std::move(opt_)[index<1>];
+        }
+        detail::throw_bad_option_access();
     }
 
     /// @brief Gets the @ref option value with a default used for `none`.
@@ -3289,7 +3298,7 @@ constexpr
 #endif
     get(option<T>& opt) {
     if constexpr (IDX == 0) {
-        if (opt.has_value()) { throw bad_option_access(); }
+        if (opt.has_value()) [[unlikely]] { detail::throw_bad_option_access(); }
     } else {
         static_assert(IDX == 1, "Invalid get index for sumty::option");
         return opt.value();
@@ -3329,7 +3338,7 @@ constexpr
 #endif
     get(const option<T>& opt) {
     if constexpr (IDX == 0) {
-        if (opt.has_value()) { throw bad_option_access(); }
+        if (opt.has_value()) [[unlikely]] { detail::throw_bad_option_access(); }
     } else {
         static_assert(IDX == 1, "Invalid get index for sumty::option");
         return opt.value();
@@ -3369,7 +3378,7 @@ constexpr
 #endif
     get(option<T>&& opt) {
     if constexpr (IDX == 0) {
-        if (opt.has_value()) { throw bad_option_access(); }
+        if (opt.has_value()) [[unlikely]] { detail::throw_bad_option_access(); }
     } else {
         static_assert(IDX == 1, "Invalid get index for sumty::option");
         return std::move(opt).value();
@@ -3409,7 +3418,7 @@ constexpr
 #endif
     get(const option<T>&& opt) {
     if constexpr (IDX == 0) {
-        if (opt.has_value()) { throw bad_option_access(); }
+        if (opt.has_value()) [[unlikely]] { detail::throw_bad_option_access(); }
     } else {
         static_assert(IDX == 1, "Invalid get index for sumty::option");
         return std::move(opt).value();
@@ -3455,7 +3464,7 @@ constexpr
 #endif
     get(option<U>& opt) {
     if constexpr (std::is_void_v<T>) {
-        if (opt.has_value()) { throw bad_option_access(); }
+        if (opt.has_value()) [[unlikely]] { detail::throw_bad_option_access(); }
     } else {
         static_assert(std::is_same_v<T, U>, "Invalid get type for sumty::option");
         return opt.value();
@@ -3501,7 +3510,7 @@ constexpr
 #endif
     get(const option<U>& opt) {
     if constexpr (std::is_void_v<T>) {
-        if (opt.has_value()) { throw bad_option_access(); }
+        if (opt.has_value()) [[unlikely]] { detail::throw_bad_option_access(); }
     } else {
         static_assert(std::is_same_v<T, U>, "Invalid get type for sumty::option");
         return opt.value();
@@ -3547,7 +3556,7 @@ constexpr
 #endif
     get(option<U>&& opt) {
     if constexpr (std::is_void_v<T>) {
-        if (opt.has_value()) { throw bad_option_access(); }
+        if (opt.has_value()) [[unlikely]] { detail::throw_bad_option_access(); }
     } else {
         static_assert(std::is_same_v<T, U>, "Invalid get type for sumty::option");
         return std::move(opt).value();
@@ -3593,7 +3602,7 @@ constexpr
 #endif
     get(const option<U>&& opt) {
     if constexpr (std::is_void_v<T>) {
-        if (opt.has_value()) { throw bad_option_access(); }
+        if (opt.has_value()) [[unlikely]] { detail::throw_bad_option_access(); }
     } else {
         static_assert(std::is_same_v<T, U>, "Invalid get type for sumty::option");
         return std::move(opt).value();
@@ -5396,4 +5405,31 @@ constexpr void swap(option<T>& a, option<T>& b)
 
 } // namespace sumty
 
+namespace std {
+
+/// @relates sumty::option
+/// @brief `std::hash` specialization for @ref sumty::option
+///
+/// @details
+/// `none` and each contained value hash differently. The contained value is
+/// hashed with `std::hash` if it is enabled for it, or else bytewise if it
+/// has unique object representations. `option<T&>` is hashed by the value
+/// it refers to, consistently with its equality comparison.
+template <typename T>
+#ifndef DOXYGEN
+    requires(sumty::detail::is_hashable_v<T>)
+#endif
+struct hash<sumty::option<T>> {
+    size_t operator()(const sumty::option<T>& opt) const {
+        if (!opt.has_value()) { return sumty::detail::hash_mix(0, 0); }
+        if constexpr (std::is_void_v<T>) {
+            return sumty::detail::hash_mix(1, 0);
+        } else {
+            return sumty::detail::hash_mix(1, sumty::detail::hash_value(*opt));
+        }
+    }
+};
+
+} // namespace std
+
 #endif
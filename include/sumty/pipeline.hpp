@@ -0,0 +1,423 @@
+/* Copyright 2024 Jack A Bernard Jr.
+ *
+ * Licensed under the Apache License, Version 2.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SUMTY_PIPELINE_HPP
+#define SUMTY_PIPELINE_HPP
+
+#include "sumty/detail/traits.hpp"
+#include "sumty/detail/utils.hpp"
+#include "sumty/option.hpp"
+#include "sumty/result.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace sumty {
+
+namespace detail {
+
+// Bounded single-producer single-consumer ring buffer. Each side caches the
+// other side's position, and only reloads it when the cached value says the
+// queue is full or empty, so a batch costs one release store and one notify.
+template <typename T>
+class spsc_queue {
+  private:
+    static constexpr size_t cache_line = 64;
+    static constexpr size_t closed_bit = size_t{1}
+                                         << (std::numeric_limits<size_t>::digits - 1);
+
+    size_t capacity_;
+    size_t mask_;
+    std::unique_ptr<option<T>[]> slots_{};
+    alignas(cache_line) std::atomic<size_t> head_{0};
+    alignas(cache_line) std::atomic<size_t> tail_{0};
+    alignas(cache_line) size_t cached_head_{0};
+    alignas(cache_line) size_t cached_tail_{0};
+
+  public:
+    explicit spsc_queue(size_t capacity)
+        : capacity_(std::bit_ceil(std::max<size_t>(capacity, 2))),
+          mask_(capacity_ - 1) {
+        slots_ = std::make_unique<option<T>[]>(capacity_);
+    }
+
+    spsc_queue(const spsc_queue&) = delete;
+    spsc_queue(spsc_queue&&) = delete;
+    ~spsc_queue() noexcept = default;
+    spsc_queue& operator=(const spsc_queue&) = delete;
+    spsc_queue& operator=(spsc_queue&&) = delete;
+
+    [[nodiscard]] size_t capacity() const noexcept { return capacity_; }
+
+    // Moves every element of [first, last) into the queue, blocking while the
+    // queue is full. Producer only.
+    template <typename It>
+    void push_batch(It first, It last) {
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        while (first != last) {
+            while (tail - cached_head_ == capacity_) {
+                head_.wait(cached_head_, std::memory_order_acquire);
+                cached_head_ = head_.load(std::memory_order_acquire);
+            }
+            const size_t space = capacity_ - (tail - cached_head_);
+            size_t count = 0;
+            for (; count < space && first != last; ++count, ++first) {
+                slots_[(tail + count) & mask_].emplace(std::move(*first));
+            }
+            tail += count;
+            tail_.store(tail, std::memory_order_release);
+            tail_.notify_one();
+        }
+    }
+
+    // Marks the queue as closed. Producer only, and at most once.
+    void close() noexcept {
+        tail_.store(tail_.load(std::memory_order_relaxed) | closed_bit,
+                    std::memory_order_release);
+        tail_.notify_one();
+    }
+
+    // Blocks until the queue is not empty, and then passes up to `max`
+    // elements to `consume`. Returns the number of elements consumed, which
+    // is only zero once the queue is closed and empty. Consumer only.
+    template <typename C>
+    size_t pop_batch(size_t max, C&& consume) {
+        size_t head = head_.load(std::memory_order_relaxed);
+        while ((cached_tail_ & ~closed_bit) == head) {
+            if ((cached_tail_ & closed_bit) != 0) { return 0; }
+            tail_.wait(cached_tail_, std::memory_order_acquire);
+            cached_tail_ = tail_.load(std::memory_order_acquire);
+        }
+        const size_t count = std::min(max, (cached_tail_ & ~closed_bit) - head);
+        for (size_t i = 0; i < count; ++i) {
+            auto& slot = slots_[(head + i) & mask_];
+            std::invoke(consume, *std::move(slot));
+            slot.reset();
+        }
+        head += count;
+        head_.store(head, std::memory_order_release);
+        head_.notify_one();
+        return count;
+    }
+};
+
+template <typename T, typename L>
+struct pipeline_prepend;
+
+template <typename T, typename... U>
+struct pipeline_prepend<T, type_list<U...>> {
+    using type = type_list<T, U...>;
+};
+
+// Computes the list of value types that flow between the stages, starting
+// with the input type and ending with the output type.
+template <typename In, typename... F>
+struct pipeline_values {
+    using type = type_list<In>;
+};
+
+template <typename In, typename F0, typename... FN>
+struct pipeline_values<In, F0, FN...> {
+    using stage_result = std::remove_cvref_t<std::invoke_result_t<F0&, In&&>>;
+
+    static_assert(is_result_v<stage_result>, "pipeline stages must return a result");
+    static_assert(std::is_object_v<typename stage_result::value_type>,
+                  "pipeline stages must return a result with an object value type");
+
+    using type = typename pipeline_prepend<
+        In,
+        typename pipeline_values<typename stage_result::value_type, FN...>::type>::type;
+};
+
+template <typename L>
+struct pipeline_queues;
+
+template <typename... V>
+struct pipeline_queues<type_list<V...>> {
+    std::tuple<spsc_queue<V>...> queues;
+
+    explicit pipeline_queues(size_t capacity)
+        : queues((static_cast<void>(sizeof(V*)), capacity)...) {}
+
+    template <size_t I>
+    using value_t = select_t<I, V...>;
+};
+
+} // namespace detail
+
+/// @class pipeline pipeline.hpp <sumty/pipeline.hpp>
+/// @brief Multi-threaded pipeline of stages that return @ref result
+///
+/// @details
+/// @ref pipeline runs each of its stages on a dedicated thread, and connects
+/// consecutive stages with bounded single-producer single-consumer queues.
+/// Each stage is a callable that accepts the value type of the previous
+/// stage by rvalue reference (or `In`, for the first stage), and returns a
+/// @ref result. Ok values are passed on to the next stage, and the values of
+/// the last stage are the output of the pipeline.
+///
+/// A stage that returns an error does not stop the pipeline. Instead, the
+/// error is passed to the error sink, along with the zero-based index of the
+/// stage that produced it, as `sink(stage, std::move(error))`. The sink is
+/// called with a lock held, so it is never called concurrently, but it may
+/// be called from any of the stage threads. If stages have different error
+/// types, the sink must accept each of them.
+///
+/// Values are transferred between stages in batches: a stage takes every
+/// available value from its input queue (up to a limit), processes them, and
+/// then publishes all of its ok values with a single atomic store. When a
+/// queue is full, the stage that feeds it blocks, so a slow stage applies
+/// backpressure all the way to @ref push. With all stages busy, throughput
+/// is bounded by the slowest stage, rather than by the sum of all stages.
+///
+/// @ref push, @ref push_batch, and @ref close must only be called by one
+/// thread at a time, and likewise for @ref pop and @ref pop_batch. The
+/// destructor closes the input if it is still open, discards any output that
+/// has not been popped, and joins the stage threads.
+///
+/// Stages and the error sink must not throw.
+///
+/// ## Example
+/// ```cpp
+/// auto pipe = make_pipeline<std::string>(
+///     [](size_t stage, const auto& err) { log_error(stage, err); },
+///     [](std::string&& line) { return parse_record(line); },
+///     [](record&& rec) { return enrich(std::move(rec)); },
+///     [](record&& rec) { return serialize(rec); }
+/// );
+///
+/// std::thread reader([&] {
+///     for (std::string line; std::getline(input, line);) {
+///         pipe.push(std::move(line));
+///     }
+///     pipe.close();
+/// });
+///
+/// while (auto out = pipe.pop()) { output << *out << '\n'; }
+/// reader.join();
+/// ```
+///
+/// @tparam In The input type of the first stage
+/// @tparam S The type of the error sink
+/// @tparam F The types of the stages
+template <typename In, typename S, typename... F>
+class pipeline {
+  private:
+    static_assert(sizeof...(F) > 0, "pipeline requires at least one stage");
+    static_assert(std::is_object_v<In>, "pipeline input must be an object type");
+
+    using values_t = typename detail::pipeline_values<In, F...>::type;
+    using queues_t = detail::pipeline_queues<values_t>;
+
+    template <size_t I>
+    using value_t = typename queues_t::template value_t<I>;
+
+    static constexpr size_t max_batch = 64;
+
+    SUMTY_NO_UNIQ_ADDR S sink_;
+    std::tuple<F...> stages_;
+    queues_t queues_;
+    size_t batch_;
+    std::mutex sink_mtx_{};
+    std::vector<std::thread> workers_{};
+    bool closed_ = false;
+
+    auto& input_queue() noexcept { return std::get<0>(queues_.queues); }
+
+    auto& output_queue() noexcept { return std::get<sizeof...(F)>(queues_.queues); }
+
+    template <size_t I>
+    void run_stage() {
+        auto& in = std::get<I>(queues_.queues);
+        auto& out = std::get<I + 1>(queues_.queues);
+        auto& func = std::get<I>(stages_);
+        std::vector<value_t<I + 1>> outputs{};
+        outputs.reserve(batch_);
+        const auto process = [&](value_t<I>&& value) {
+            auto res = std::invoke(func, std::move(value));
+            if (res.has_value()) {
+                outputs.push_back(*std::move(res));
+            } else {
+                const std::lock_guard lock{sink_mtx_};
+                std::invoke(sink_, I, std::move(res).error());
+            }
+        };
+        while (in.pop_batch(batch_, process) != 0) {
+            out.push_batch(outputs.begin(), outputs.end());
+            outputs.clear();
+        }
+        out.close();
+    }
+
+    // Closes the queues after stages whose threads were never started, so
+    // that the started stages and the output still see the end of input.
+    void close_unstarted() noexcept {
+        [this]<size_t... I>([[maybe_unused]] std::index_sequence<I...> seq) {
+            ((I >= workers_.size() ? std::get<I + 1>(queues_.queues).close() : void()),
+             ...);
+        }(std::index_sequence_for<F...>{});
+    }
+
+    void shutdown() noexcept {
+        close();
+        while (output_queue().pop_batch(std::numeric_limits<size_t>::max(),
+                                        []([[maybe_unused]] auto&& value) {}) != 0) {}
+        for (auto& worker : workers_) {
+            if (worker.joinable()) { worker.join(); }
+        }
+    }
+
+  public:
+    using input_type = In;
+    using output_type = value_t<sizeof...(F)>;
+
+    /// @brief Constructs a @ref pipeline and starts its stage threads
+    ///
+    /// @param capacity The minimum number of values each queue between
+    /// stages can hold. The actual capacity is rounded up to a power of two.
+    /// @param sink The error sink
+    /// @param stages The stages, in order
+    pipeline(size_t capacity, S sink, F... stages)
+        : sink_(std::move(sink)),
+          stages_(std::move(stages)...),
+          queues_(capacity),
+          batch_(std::min(max_batch, input_queue().capacity())) {
+        workers_.reserve(sizeof...(F));
+        try {
+            [this]<size_t... I>([[maybe_unused]] std::index_sequence<I...> seq) {
+                (workers_.emplace_back([this] { run_stage<I>(); }), ...);
+            }(std::index_sequence_for<F...>{});
+        } catch (...) {
+            close_unstarted();
+            shutdown();
+            throw;
+        }
+    }
+
+    pipeline(const pipeline&) = delete;
+    pipeline(pipeline&&) = delete;
+
+    ~pipeline() noexcept { shutdown(); }
+
+    pipeline& operator=(const pipeline&) = delete;
+    pipeline& operator=(pipeline&&) = delete;
+
+    /// @brief Gets the number of stages
+    [[nodiscard]] static constexpr size_t stage_count() noexcept { return sizeof...(F); }
+
+    /// @brief Pushes a value into the first stage
+    ///
+    /// @details
+    /// Blocks while the input queue is full. The input must not be closed.
+    void push(In value) {
+        auto* first = std::addressof(value);
+        input_queue().push_batch(first, first + 1);
+    }
+
+    /// @brief Moves a range of values into the first stage
+    ///
+    /// @details
+    /// The values are transferred in as few batches as the capacity of the
+    /// input queue allows. Blocks while the input queue is full. The input
+    /// must not be closed.
+    template <typename It>
+    void push_batch(It first, It last) {
+        input_queue().push_batch(std::move(first), std::move(last));
+    }
+
+    /// @brief Closes the input of the pipeline
+    ///
+    /// @details
+    /// Once every value that was pushed before has been processed, the
+    /// output is closed, and @ref pop returns `none`. Closing an already
+    /// closed input has no effect.
+    void close() noexcept {
+        if (!std::exchange(closed_, true)) { input_queue().close(); }
+    }
+
+    /// @brief Pops a value from the output of the last stage
+    ///
+    /// @details
+    /// Blocks until a value is available.
+    ///
+    /// @return The value, or `none` if the pipeline is closed and every value
+    /// has been popped.
+    option<output_type> pop() {
+        option<output_type> ret{};
+        output_queue().pop_batch(
+            1, [&](output_type&& value) { ret.emplace(std::move(value)); });
+        return ret;
+    }
+
+    /// @brief Pops up to `max` values from the output of the last stage
+    ///
+    /// @details
+    /// Blocks until at least one value is available, and then writes every
+    /// available value, up to `max`, to `out`.
+    ///
+    /// @return The number of values written, which is only zero if the
+    /// pipeline is closed and every value has been popped.
+    template <typename OutIt>
+    size_t pop_batch(OutIt out, size_t max) {
+        return output_queue().pop_batch(max, [&](output_type&& value) {
+            *out = std::move(value);
+            ++out;
+        });
+    }
+};
+
+/// @relates pipeline
+/// @brief Creates a @ref pipeline with a given queue capacity
+///
+/// @param capacity The minimum number of values each queue between stages
+/// can hold
+/// @param sink The error sink
+/// @param stages The stages, in order
+template <typename In, typename S, typename... F>
+pipeline<In, std::decay_t<S>, std::decay_t<F>...> make_pipeline(size_t capacity,
+                                                                 S&& sink,
+                                                                 F&&... stages) {
+    return pipeline<In, std::decay_t<S>, std::decay_t<F>...>(
+        capacity, std::forward<S>(sink), std::forward<F>(stages)...);
+}
+
+/// @relates pipeline
+/// @brief Creates a @ref pipeline with the default queue capacity of 1024
+///
+/// @param sink The error sink
+/// @param stages The stages, in order
+template <typename In, typename S, typename... F>
+#ifndef DOXYGEN
+    requires(!std::is_integral_v<std::remove_cvref_t<S>>)
+#endif
+pipeline<In, std::decay_t<S>, std::decay_t<F>...> make_pipeline(S&& sink, F&&... stages) {
+    return pipeline<In, std::decay_t<S>, std::decay_t<F>...>(
+        1024, std::forward<S>(sink), std::forward<F>(stages)...);
+}
+
+} // namespace sumty
+
+#endif
@@ -17,6 +17,7 @@
 #define SUMTY_RESULT_HPP
 
 #include "sumty/detail/fwd.hpp"    // IWYU pragma: export
+#include "sumty/detail/hash.hpp"
 #include "sumty/detail/traits.hpp" // IWYU pragma: export
 #include "sumty/detail/utils.hpp"
 #include "sumty/exceptions.hpp"
@@ -1621,47 +1622,47 @@ class result {
     }
 
     [[nodiscard]] constexpr reference value() & {
-        if (res_.index() != 0) {
-            if constexpr (std::is_void_v<E>) {
-                throw bad_result_access<void>();
-            } else {
-                throw bad_result_access<std::remove_cvref_t<E>>(res_[index<1>]);
-            }
+        if (res_.index() == 0) [[likely]] {
+            return res_[index<0>];
+        }
+        if constexpr (std::is_void_v<E>) {
+            detail::throw_bad_result_access();
+        } else {
+            detail::throw_bad_result_access(res_[index<1>]);
         }
-        return res_[index<0>];
     }
 
     [[nodiscard]] constexpr const_reference value() const& {
-        if (res_.index() != 0) {
-            if constexpr (std::is_void_v<E>) {
-                throw bad_result_access<void>();
-            } else {
-                throw bad_result_access<std::remove_cvref_t<E>>(res_[index<1>]);
-            }
+        if (res_.index() == 0) [[likely]] {
+            return res_[index<0>];
+        }
+        if constexpr (std::is_void_v<E>) {
+            detail::throw_bad_result_access();
+        } else {
+            detail::throw_bad_result_access(res_[index<1>]);
         }
-        return res_[index<0>];
     }
 
     [[nodiscard]] constexpr rvalue_reference value() && {
-        if (res_.index() != 0) {
-            if constexpr (std::is_void_v<E>) {
-                throw bad_result_access<void>();
-            } else {
-                throw bad_result_access<std::remove_cvref_t<E>>(std::move(res_)[index<1>]);
-            }
+        if (res_.index() == 0) [[likely]] {
+            return std::move(res_)[index<0>];
+        }
+        if constexpr (std::is_void_v<E>) {
+            detail::throw_bad_result_access();
+        } else {
+            detail::throw_bad_result_access(std::move(res_)[index<1>]);
         }
-        return std::move(res_)[index<0>];
     }
 
     [[nodiscard]] constexpr rvalue_reference value() const&& {
-        if (res_.index() != 0) {
-            if constexpr (std::is_void_v<E>) {
-                throw bad_result_access<void>();
-            } else {
-                throw bad_result_access<std::remove_cvref_t<E>>(std::move(res_)[index<1>]);
-            }
+        if (res_.index() == 0) [[likely]] {
+            return std::move(res_)[index<0>];
+        }
+        if constexpr (std::is_void_v<E>) {
+            detail::throw_bad_result_access();
+        } else {
+            detail::throw_bad_result_access(std::move(res_)[index<1>]);
         }
-        return std::move(res_)[index<0>];
     }
 
     [[nodiscard]] constexpr error_reference error() & noexcept { return res_[index<1>]; }
@@ -2632,4 +2633,40 @@ constexpr void swap(result<T, E>& a, result<T, E>& b)
 
 } // namespace sumty
 
+namespace std {
+
+/// @relates sumty::result
+/// @brief `std::hash` specialization for @ref sumty::result
+///
+/// @details
+/// The hash combines whether the @ref sumty::result holds a value or an
+/// error with the hash of the value or error, so equal values and errors
+/// hash differently. Values and errors are hashed with `std::hash` if it is
+/// enabled for them, or else bytewise if they have unique object
+/// representations. `void` values and errors only contribute which of the
+/// two is held, and references are hashed by the value they refer to.
+template <typename T, typename E>
+#ifndef DOXYGEN
+    requires(sumty::detail::is_hashable_v<T> && sumty::detail::is_hashable_v<E>)
+#endif
+struct hash<sumty::result<T, E>> {
+    size_t operator()(const sumty::result<T, E>& res) const {
+        if (res.has_value()) {
+            if constexpr (std::is_void_v<T>) {
+                return sumty::detail::hash_mix(0, 0);
+            } else {
+                return sumty::detail::hash_mix(0, sumty::detail::hash_value(*res));
+            }
+        } else {
+            if constexpr (std::is_void_v<E>) {
+                return sumty::detail::hash_mix(1, 0);
+            } else {
+                return sumty::detail::hash_mix(1, sumty::detail::hash_value(res.error()));
+            }
+        }
+    }
+};
+
+} // namespace std
+
 #endif
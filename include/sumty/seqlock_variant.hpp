@@ -0,0 +1,181 @@
+/* Copyright 2024 Jack A Bernard Jr.
+ *
+ * Licensed under the Apache License, Version 2.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SUMTY_SEQLOCK_VARIANT_HPP
+#define SUMTY_SEQLOCK_VARIANT_HPP
+
+#include "sumty/detail/atomic.hpp"
+#include "sumty/variant.hpp"
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace sumty {
+
+/// @brief Trait that determines if a type may be copied into a
+/// @ref seqlock_variant snapshot
+///
+/// @details
+/// Snapshots are taken by copying the object representation of the stored
+/// alternative, so only trivially copyable types (as well as `void` and
+/// lvalue references) are snapshot copyable. Copying the bytes of any other
+/// type does not create an object, so this trait must not be specialized.
+template <typename T>
+struct is_snapshot_copyable : detail::is_bitwise_copyable<T> {};
+
+/// @relates is_snapshot_copyable
+template <typename T>
+static inline constexpr bool is_snapshot_copyable_v = is_snapshot_copyable<T>::value;
+
+/// @class seqlock_variant seqlock_variant.hpp <sumty/seqlock_variant.hpp>
+/// @brief @ref variant shared between threads using a sequence lock
+///
+/// @details
+/// @ref seqlock_variant is intended for read-mostly state that is too large
+/// for @ref atomic_variant to be lock-free. Writers serialize on a sequence
+/// counter, which is odd while a write is in progress. Readers never write to
+/// shared memory: they copy the packed representation and retry if the
+/// sequence counter changed during the copy. As a result, concurrent readers
+/// do not contend with each other, no matter how many there are.
+///
+/// Every alternative must satisfy @ref is_snapshot_copyable.
+///
+/// ## Example
+/// ```cpp
+/// struct book { std::array<double, 16> bids; std::array<double, 16> asks; };
+/// struct halted { int64_t since; };
+///
+/// seqlock_variant<book, halted> market{};
+///
+/// // writer
+/// market.update([](variant<book, halted>& state) noexcept {
+///     if (state.index() == 0) { get<0>(state).bids[0] = 101.25; }
+/// });
+///
+/// // readers
+/// auto best_bid = market.visit(overload(
+///     [](const book& b) { return b.bids[0]; },
+///     [](const halted&) { return 0.0; }
+/// ));
+/// ```
+///
+/// @tparam T The alternative types of the contained @ref variant
+template <typename... T>
+class seqlock_variant {
+  private:
+    static_assert((detail::is_bitwise_copyable<T>::value && ...),
+                  "seqlock_variant requires trivially copyable alternatives");
+
+    using codec_t = detail::variant_codec<variant<T...>>;
+
+    detail::seqlock_storage<codec_t::size> storage_;
+
+  public:
+    using value_type = variant<T...>;
+
+    /// @brief Constructs a @ref seqlock_variant holding a default constructed
+    /// first alternative
+    seqlock_variant() noexcept : storage_(codec_t::pack(variant<T...>{})) {}
+
+    /// @brief Constructs a @ref seqlock_variant with an initial value
+    // NOLINTNEXTLINE(hicpp-explicit-conversions)
+    seqlock_variant(const variant<T...>& init) noexcept : storage_(codec_t::pack(init)) {}
+
+    /// @brief Constructs a @ref seqlock_variant holding the alternative at
+    /// index `IDX`, constructed in place
+    template <size_t IDX, typename... Args>
+    explicit seqlock_variant(std::in_place_index_t<IDX> inplace, Args&&... args)
+        : storage_(codec_t::pack(variant<T...>(inplace, std::forward<Args>(args)...))) {}
+
+    seqlock_variant(const seqlock_variant&) = delete;
+
+    seqlock_variant& operator=(const seqlock_variant&) = delete;
+
+    ~seqlock_variant() noexcept = default;
+
+    /// @brief Takes a consistent snapshot of the value
+    ///
+    /// @details
+    /// This function does not write to shared memory. If a writer is active
+    /// or completes a write during the copy, the copy is retried.
+    [[nodiscard]] variant<T...> load() const noexcept {
+        return codec_t::unpack(storage_.load());
+    }
+
+    /// @brief Gets the index of the alternative in a consistent snapshot
+    [[nodiscard]] size_t index() const noexcept {
+        return codec_t::index_of(storage_.load());
+    }
+
+    /// @brief Replaces the value
+    void store(const variant<T...>& desired) noexcept {
+        storage_.store(codec_t::pack(desired));
+    }
+
+    /// @brief Replaces the value and returns the previous value
+    variant<T...> exchange(const variant<T...>& desired) noexcept {
+        return codec_t::unpack(storage_.exchange(codec_t::pack(desired)));
+    }
+
+    /// @brief Modifies the value in place while holding the write lock
+    ///
+    /// @details
+    /// `func` is called with a mutable reference to a copy of the current
+    /// value, which is published when `func` returns. Other writers are
+    /// blocked until then, so `func` should be short, and it must not
+    /// throw.
+    template <typename F>
+#ifndef DOXYGEN
+        requires(std::is_nothrow_invocable_v<F, variant<T...>&>)
+#endif
+    void update(F&& func) noexcept {
+        storage_.update([&func](typename codec_t::bytes& bytes) noexcept {
+            auto value = codec_t::unpack(bytes);
+            std::forward<F>(func)(value);
+            bytes = codec_t::pack(value);
+        });
+    }
+
+    /// @brief Calls a visitor with the alternative of a consistent snapshot
+    ///
+    /// @details
+    /// The visitor is called as if by `load().visit(visitor)`. Because the
+    /// snapshot does not outlive the call, the result of the visitor is
+    /// returned by value.
+    template <typename V>
+    auto visit(V&& visitor) const {
+        const auto snapshot = load();
+        return snapshot.visit(std::forward<V>(visitor));
+    }
+
+    /// @brief Blocks until the value is no longer equal to `old`
+    ///
+    /// @details
+    /// Like `std::atomic::wait`, this function is only guaranteed to return
+    /// after the value has been changed and @ref notify_one or
+    /// @ref notify_all has been called.
+    void wait(const variant<T...>& old) const noexcept {
+        storage_.wait(codec_t::pack(old));
+    }
+
+    void notify_one() noexcept { storage_.notify_one(); }
+
+    void notify_all() noexcept { storage_.notify_all(); }
+};
+
+} // namespace sumty
+
+#endif
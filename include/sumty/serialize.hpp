@@ -0,0 +1,610 @@
+/* Copyright 2024 Jack A Bernard Jr.
+ *
+ * Licensed under the Apache License, Version 2.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SUMTY_SERIALIZE_HPP
+#define SUMTY_SERIALIZE_HPP
+
+#include "sumty/detail/utils.hpp"
+#include "sumty/error_set.hpp"
+#include "sumty/option.hpp"
+#include "sumty/result.hpp"
+#include "sumty/utils.hpp"
+#include "sumty/variant.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace sumty {
+
+/// @brief Error returned by @ref deserialize
+enum class decode_error : uint8_t {
+    /// The input ended before the value was complete
+    unexpected_end,
+    /// A varint was longer than 10 bytes or did not fit in 64 bits
+    invalid_varint,
+    /// A discriminant did not match any alternative
+    unknown_alternative,
+    /// A payload was rejected by its codec
+    invalid_value,
+};
+
+/// @brief Concept for a destination of serialized bytes
+///
+/// @details
+/// A writer has a `write` member function that appends a span of bytes.
+template <typename W>
+concept byte_writer = requires(W& writer, std::span<const std::byte> bytes) {
+    writer.write(bytes);
+};
+
+/// @brief Concept for a source of serialized bytes
+///
+/// @details
+/// A reader has a `read` member function that fills a span of bytes with the
+/// next bytes of input, and returns `false` if there are not enough bytes
+/// left.
+template <typename R>
+concept byte_reader = requires(R& reader, std::span<std::byte> bytes) {
+    { reader.read(bytes) } -> std::convertible_to<bool>;
+};
+
+/// @brief @ref byte_writer that appends to a `std::vector<std::byte>`
+class vector_writer {
+  private:
+    std::vector<std::byte>* buf_;
+
+  public:
+    /// @brief Constructs a writer that appends to `buf`
+    constexpr explicit vector_writer(std::vector<std::byte>& buf) noexcept
+        : buf_(std::addressof(buf)) {}
+
+    /// @brief Appends `bytes` to the buffer
+    void write(std::span<const std::byte> bytes) {
+        buf_->insert(buf_->end(), bytes.begin(), bytes.end());
+    }
+};
+
+/// @brief @ref byte_reader that reads from a span of bytes
+class span_reader {
+  private:
+    std::span<const std::byte> bytes_;
+
+  public:
+    /// @brief Constructs a reader over `bytes`
+    constexpr explicit span_reader(std::span<const std::byte> bytes) noexcept
+        : bytes_(bytes) {}
+
+    /// @brief Copies the next `out.size()` bytes into `out`
+    ///
+    /// @return `false`, without consuming any input, if fewer than
+    /// `out.size()` bytes remain.
+    constexpr bool read(std::span<std::byte> out) noexcept {
+        if (out.size() > bytes_.size()) { return false; }
+        std::copy_n(bytes_.begin(), out.size(), out.begin());
+        bytes_ = bytes_.subspan(out.size());
+        return true;
+    }
+
+    /// @brief Gets the number of bytes that have not been read yet
+    [[nodiscard]] constexpr size_t remaining() const noexcept { return bytes_.size(); }
+};
+
+/// @brief Customization point that assigns a stable id to an alternative
+///
+/// @details
+/// When every alternative of a @ref variant or @ref error_set has a stable
+/// id, the id is written as the discriminant instead of the index of the
+/// alternative. Alternatives can then be reordered, added, or removed
+/// without making previously serialized data unreadable. It is a compile
+/// error for only some of the alternatives to have a stable id, since the
+/// others would then be identified by an index that changes as soon as an
+/// alternative is added.
+///
+/// Specializations define either an explicit `id`, or a `name` that is
+/// hashed into an id. Small explicit ids give the most compact encoding.
+///
+/// ```cpp
+/// template <>
+/// struct sumty::serial_descriptor<timeout_error> {
+///     static constexpr std::string_view name = "net.timeout";
+/// };
+///
+/// template <>
+/// struct sumty::serial_descriptor<refused_error> {
+///     static constexpr uint64_t id = 2;
+/// };
+/// ```
+template <typename T>
+struct serial_descriptor {};
+
+/// @brief Customization point that encodes and decodes a type
+///
+/// @details
+/// Specializations define a static `encode` function that writes a value to
+/// a @ref byte_writer, and a static `decode` function that reads a value
+/// from a @ref byte_reader and returns it as a @ref result with
+/// @ref decode_error as the error type.
+///
+/// Codecs are provided for arithmetic types, empty trivially copyable types,
+/// and types that opt in with @ref raw_serializable, which are written as
+/// their object representation, as well as `bool`, `std::basic_string`, and
+/// the sum types of sumty.
+///
+/// ```cpp
+/// template <>
+/// struct sumty::codec<point> {
+///     static void encode(byte_writer auto& writer, const point& value) {
+///         serialize(writer, value.x);
+///         serialize(writer, value.y);
+///     }
+///
+///     static result<point, decode_error> decode(byte_reader auto& reader) {
+///         auto x = deserialize<int>(reader);
+///         if (!x) { return error<decode_error>(x.error()); }
+///         auto y = deserialize<int>(reader);
+///         if (!y) { return error<decode_error>(y.error()); }
+///         return point{*x, *y};
+///     }
+/// };
+/// ```
+template <typename T>
+struct codec {};
+
+/// @brief Customization point that opts a type into the raw codec
+///
+/// @details
+/// The raw codec writes the object representation of a value, and reads it
+/// back with `std::bit_cast`. That is only meaningful for types whose bytes
+/// are their whole value, so apart from arithmetic types and empty types, it
+/// must be enabled explicitly by deriving a specialization from
+/// `std::true_type`. Such a type must be trivially copyable, must not have
+/// padding, so that the encoding is deterministic, and must not hold
+/// pointers or references, which would not be meaningful once decoded.
+/// String and span views are never serialized raw.
+///
+/// The specialization may define a static `valid` function, which is called
+/// with each decoded value, and fails decoding with
+/// @ref decode_error::invalid_value if it returns `false`. Enumerations must
+/// define `valid`, since not every value of the underlying type is
+/// necessarily an enumerator.
+///
+/// ```cpp
+/// template <>
+/// struct sumty::raw_serializable<rgb> : std::true_type {};
+///
+/// template <>
+/// struct sumty::raw_serializable<color> : std::true_type {
+///     static constexpr bool valid(color value) noexcept {
+///         return value == color::red || value == color::green;
+///     }
+/// };
+/// ```
+template <typename T>
+struct raw_serializable : std::false_type {};
+
+namespace detail {
+
+// The reader and writer concepts are generic, so codecs are checked against
+// the builtin reader and writer.
+template <typename T>
+static inline constexpr bool has_codec_v =
+    requires(vector_writer& writer, span_reader& reader, const T& value) {
+        codec<T>::encode(writer, value);
+        { codec<T>::decode(reader) } -> std::same_as<result<T, decode_error>>;
+    };
+
+template <typename T>
+static inline constexpr bool is_serializable_v = std::is_void_v<T> || has_codec_v<T>;
+
+template <typename T>
+static inline constexpr bool is_view_v = false;
+
+template <typename Char, typename Traits>
+static inline constexpr bool is_view_v<std::basic_string_view<Char, Traits>> = true;
+
+template <typename T, size_t N>
+static inline constexpr bool is_view_v<std::span<T, N>> = true;
+
+// long double is excluded, since it has padding bytes on common ABIs
+template <typename T>
+static inline constexpr bool is_raw_serializable_v =
+    std::is_object_v<T> && !std::is_const_v<T> && !std::is_volatile_v<T> && !is_view_v<T> &&
+    ((std::is_arithmetic_v<T> && !std::is_same_v<T, bool> &&
+      !std::is_same_v<T, long double>) ||
+     (std::is_class_v<T> && std::is_empty_v<T> && std::is_trivially_copyable_v<T>) ||
+     raw_serializable<T>::value);
+
+template <typename T>
+static inline constexpr bool has_raw_validator_v = requires(const T& value) {
+    { raw_serializable<T>::valid(value) } -> std::convertible_to<bool>;
+};
+
+constexpr uint64_t fnv1a(std::string_view str) noexcept {
+    uint64_t hash = 0xcbf29ce484222325U;
+    for (const char chr : str) {
+        hash ^= static_cast<unsigned char>(chr);
+        hash *= 0x100000001b3U;
+    }
+    return hash;
+}
+
+template <typename T>
+static inline constexpr bool has_serial_id_v =
+    requires { serial_descriptor<T>::id; } || requires { serial_descriptor<T>::name; };
+
+template <typename T>
+consteval uint64_t serial_id() noexcept {
+    if constexpr (requires { serial_descriptor<T>::id; }) {
+        return serial_descriptor<T>::id;
+    } else {
+        // truncated to 32 bits, so that the varint takes at most 5 bytes
+        return fnv1a(serial_descriptor<T>::name) & 0xffffffffU;
+    }
+}
+
+template <typename... T>
+consteval std::array<uint64_t, sizeof...(T)> discriminants() noexcept {
+    // Falling back to indices when only some alternatives have ids would
+    // silently change the encoding of the others when one more is added.
+    static_assert((has_serial_id_v<T> && ...) || (!has_serial_id_v<T> && ...),
+                  "either all or none of the alternatives must have a serial_descriptor");
+    if constexpr (sizeof...(T) > 0 && (has_serial_id_v<T> && ...)) {
+        return {serial_id<T>()...};
+    } else {
+        return []<size_t... I>([[maybe_unused]] std::index_sequence<I...> seq) {
+            return std::array<uint64_t, sizeof...(T)>{I...};
+        }(std::index_sequence_for<T...>{});
+    }
+}
+
+template <typename... T>
+consteval bool all_unique_discriminants() noexcept {
+    const auto ids = discriminants<T...>();
+    for (size_t i = 0; i < ids.size(); ++i) {
+        for (size_t j = i + 1; j < ids.size(); ++j) {
+            if (ids[i] == ids[j]) { return false; }
+        }
+    }
+    return true;
+}
+
+template <typename W>
+void write_varint(W& writer, uint64_t value) {
+    std::array<std::byte, 10> buf{};
+    size_t len = 0;
+    while (value >= 0x80U) {
+        buf[len++] = static_cast<std::byte>((value & 0x7fU) | 0x80U);
+        value >>= 7U;
+    }
+    buf[len++] = static_cast<std::byte>(value);
+    writer.write(std::span<const std::byte>(buf.data(), len));
+}
+
+template <typename R>
+result<uint64_t, decode_error> read_varint(R& reader) {
+    uint64_t value = 0;
+    for (unsigned shift = 0; shift < 64U; shift += 7U) {
+        std::array<std::byte, 1> byte{};
+        if (!reader.read(std::span<std::byte>(byte))) {
+            return result<uint64_t, decode_error>{in_place_error,
+                                                  decode_error::unexpected_end};
+        }
+        const auto bits = std::to_integer<uint64_t>(byte[0]);
+        if (shift == 63U && bits > 1U) { break; }
+        value |= (bits & 0x7fU) << shift;
+        if ((bits & 0x80U) == 0) { return value; }
+    }
+    return result<uint64_t, decode_error>{in_place_error, decode_error::invalid_varint};
+}
+
+template <typename T>
+result<T, decode_error> decode_failure(decode_error err) {
+    return result<T, decode_error>{in_place_error, err};
+}
+
+template <typename V, size_t I, typename R, typename F, typename... T>
+result<V, decode_error> decode_alternative_at(R& reader, const F& make) {
+    using alt_t = select_t<I, T...>;
+    if constexpr (std::is_void_v<alt_t>) {
+        return make(std::in_place_index<I>);
+    } else {
+        auto payload = codec<alt_t>::decode(reader);
+        if (!payload.has_value()) { return decode_failure<V>(payload.error()); }
+        return make(std::in_place_index<I>, *std::move(payload));
+    }
+}
+
+// Reads a discriminant from ids and decodes the alternative of T... it
+// names. The decoded payload is moved once, into the value that make
+// constructs, and that value is returned without further moves.
+template <typename V, typename... T, typename R, typename F>
+result<V, decode_error> decode_alternative(R& reader,
+                                           const std::array<uint64_t, sizeof...(T)>& ids,
+                                           const F& make) {
+    auto disc = read_varint(reader);
+    if (!disc.has_value()) { return decode_failure<V>(disc.error()); }
+    const auto* pos = std::find(ids.begin(), ids.end(), *disc);
+    if (pos == ids.end()) { return decode_failure<V>(decode_error::unknown_alternative); }
+    return [&]<size_t... I>([[maybe_unused]] std::index_sequence<I...> seq) {
+        static constexpr std::array<result<V, decode_error> (*)(R&, const F&), sizeof...(T)>
+            table{&decode_alternative_at<V, I, R, F, T...>...};
+        return table[static_cast<size_t>(pos - ids.begin())](reader, make);
+    }(std::index_sequence_for<T...>{});
+}
+
+} // namespace detail
+
+/// @brief Concept for a type that can be serialized with @ref serialize
+template <typename T>
+concept serializable = detail::has_codec_v<T>;
+
+/// @brief Writes a value to a @ref byte_writer
+///
+/// @details
+/// The value is encoded with its @ref codec specialization. A @ref variant
+/// or @ref error_set is encoded as a varint discriminant followed by the
+/// held alternative, which is nothing for `void`. The discriminant is the
+/// index of the alternative, or its stable id if every alternative has a
+/// @ref serial_descriptor. @ref option and @ref result are encoded the same
+/// way as a two-alternative @ref variant.
+///
+/// Arithmetic types and @ref raw_serializable types are written as their
+/// object representation, so the encoding is only portable between hosts
+/// with the same byte order and type sizes.
+///
+/// ## Example
+/// ```cpp
+/// std::vector<std::byte> buf;
+/// variant<int, std::string> v{std::in_place_index<1>, "hello"};
+///
+/// serialize(vector_writer{buf}, v);
+///
+/// assert(buf.size() == 7);
+/// ```
+///
+/// @param writer The destination of the encoded bytes
+/// @param value The value to encode
+template <typename W, typename T>
+#ifndef DOXYGEN
+    requires(byte_writer<std::remove_cvref_t<W>> && serializable<T>)
+#endif
+void serialize(W&& writer, const T& value) {
+    codec<T>::encode(writer, value);
+}
+
+/// @brief Reads a value from a @ref byte_reader
+///
+/// @details
+/// This is the inverse of @ref serialize. The value is constructed directly
+/// from the decoded payload, so types that are not default constructible
+/// can be decoded.
+///
+/// ## Example
+/// ```cpp
+/// std::vector<std::byte> buf;
+/// serialize(vector_writer{buf}, variant<int, std::string>{std::in_place_index<0>, 42});
+///
+/// auto res = deserialize<variant<int, std::string>>(span_reader{buf});
+///
+/// assert(res.has_value());
+/// assert((*res)[index<0>] == 42);
+/// ```
+///
+/// @tparam T The type of the value to decode
+/// @param reader The source of the encoded bytes
+/// @return The decoded value, or the reason that decoding failed
+template <typename T, typename R>
+#ifndef DOXYGEN
+    requires(byte_reader<std::remove_cvref_t<R>> && serializable<T>)
+#endif
+result<T, decode_error> deserialize(R&& reader) {
+    return codec<T>::decode(reader);
+}
+
+#ifndef DOXYGEN
+
+template <typename T>
+    requires(detail::is_raw_serializable_v<T>)
+struct codec<T> {
+    static_assert(std::is_trivially_copyable_v<T>,
+                  "raw_serializable types must be trivially copyable");
+    static_assert(std::is_arithmetic_v<T> || std::is_empty_v<T> ||
+                      std::has_unique_object_representations_v<T>,
+                  "raw_serializable types must not have padding");
+    static_assert(!std::is_enum_v<T> || detail::has_raw_validator_v<T>,
+                  "raw_serializable specializations for enumerations must define valid");
+
+    // empty types have no payload
+    static void encode(byte_writer auto& writer, const T& value) {
+        if constexpr (!std::is_empty_v<T>) {
+            writer.write(std::as_bytes(std::span<const T, 1>(std::addressof(value), 1)));
+        }
+    }
+
+    static result<T, decode_error> decode(byte_reader auto& reader) {
+        std::array<std::byte, sizeof(T)> buf{};
+        if (!std::is_empty_v<T> && !reader.read(std::span<std::byte>(buf))) {
+            return detail::decode_failure<T>(decode_error::unexpected_end);
+        }
+        const auto value = std::bit_cast<T>(buf);
+        if constexpr (detail::has_raw_validator_v<T>) {
+            if (!raw_serializable<T>::valid(value)) {
+                return detail::decode_failure<T>(decode_error::invalid_value);
+            }
+        }
+        return result<T, decode_error>{std::in_place, value};
+    }
+};
+
+template <>
+struct codec<bool> {
+    static void encode(byte_writer auto& writer, bool value) {
+        const std::array<std::byte, 1> buf{value ? std::byte{1} : std::byte{0}};
+        writer.write(std::span<const std::byte>(buf));
+    }
+
+    static result<bool, decode_error> decode(byte_reader auto& reader) {
+        std::array<std::byte, 1> buf{};
+        if (!reader.read(std::span<std::byte>(buf))) {
+            return detail::decode_failure<bool>(decode_error::unexpected_end);
+        }
+        if (std::to_integer<unsigned>(buf[0]) > 1U) {
+            return detail::decode_failure<bool>(decode_error::invalid_value);
+        }
+        return buf[0] == std::byte{1};
+    }
+};
+
+template <typename Char, typename Traits, typename Alloc>
+    requires(std::is_trivially_copyable_v<Char>)
+struct codec<std::basic_string<Char, Traits, Alloc>> {
+    using string_t = std::basic_string<Char, Traits, Alloc>;
+
+    static void encode(byte_writer auto& writer, const string_t& value) {
+        detail::write_varint(writer, value.size());
+        writer.write(std::as_bytes(std::span<const Char>(value.data(), value.size())));
+    }
+
+    static result<string_t, decode_error> decode(byte_reader auto& reader) {
+        auto len = detail::read_varint(reader);
+        if (!len.has_value()) { return detail::decode_failure<string_t>(len.error()); }
+        // the string grows in bounded steps, so that a corrupt length fails
+        // with unexpected_end instead of a huge allocation
+        static constexpr uint64_t step = 4096 / sizeof(Char) + 1;
+        string_t ret{};
+        for (uint64_t left = *len; left > 0;) {
+            const auto count = std::min(left, step);
+            const size_t old_size = ret.size();
+            ret.resize(old_size + count);
+            if (!reader.read(std::as_writable_bytes(
+                    std::span<Char>(ret.data() + old_size, count)))) {
+                return detail::decode_failure<string_t>(decode_error::unexpected_end);
+            }
+            left -= count;
+        }
+        return ret;
+    }
+};
+
+template <typename... T>
+    requires(detail::is_serializable_v<T> && ...)
+struct codec<variant<T...>> {
+    static_assert(detail::all_unique_discriminants<T...>(),
+                  "alternatives must have unique serial ids");
+
+    static void encode(byte_writer auto& writer, const variant<T...>& value) {
+        value.visit_informed([&writer](const auto& alt, auto info) {
+            constexpr size_t IDX = decltype(info)::index;
+            detail::write_varint(writer, detail::discriminants<T...>()[IDX]);
+            if constexpr (!std::is_void_v<typename decltype(info)::type>) {
+                codec<typename decltype(info)::type>::encode(writer, alt);
+            }
+        });
+    }
+
+    static result<variant<T...>, decode_error> decode(byte_reader auto& reader) {
+        return detail::decode_alternative<variant<T...>, T...>(
+            reader, detail::discriminants<T...>(), [](auto inplace, auto&&... args) {
+                return result<variant<T...>, decode_error>{
+                    std::in_place, inplace, std::forward<decltype(args)>(args)...};
+            });
+    }
+};
+
+template <typename... T>
+    requires(detail::is_serializable_v<T> && ...)
+struct codec<error_set<T...>> {
+    static_assert(detail::all_unique_discriminants<T...>(),
+                  "alternatives must have unique serial ids");
+
+    static void encode(byte_writer auto& writer, const error_set<T...>& value) {
+        value.visit_informed([&writer](const auto& alt, auto info) {
+            constexpr size_t IDX = decltype(info)::index;
+            detail::write_varint(writer, detail::discriminants<T...>()[IDX]);
+            codec<typename decltype(info)::type>::encode(writer, alt);
+        });
+    }
+
+    static result<error_set<T...>, decode_error> decode(byte_reader auto& reader) {
+        return detail::decode_alternative<error_set<T...>, T...>(
+            reader, detail::discriminants<T...>(), [](auto inplace, auto&&... args) {
+                return result<error_set<T...>, decode_error>{
+                    std::in_place, inplace, std::forward<decltype(args)>(args)...};
+            });
+    }
+};
+
+template <typename T>
+    requires(!std::is_reference_v<T> && detail::is_serializable_v<T>)
+struct codec<option<T>> {
+    static void encode(byte_writer auto& writer, const option<T>& value) {
+        detail::write_varint(writer, value.has_value() ? 1U : 0U);
+        if constexpr (!std::is_void_v<T>) {
+            if (value.has_value()) { codec<T>::encode(writer, *value); }
+        }
+    }
+
+    static result<option<T>, decode_error> decode(byte_reader auto& reader) {
+        return detail::decode_alternative<option<T>, void, T>(
+            reader, std::array<uint64_t, 2>{0, 1}, [](auto inplace, auto&&... args) {
+                if constexpr (std::is_same_v<decltype(inplace), std::in_place_index_t<0>>) {
+                    return result<option<T>, decode_error>{};
+                } else {
+                    return result<option<T>, decode_error>{
+                        std::in_place, std::in_place,
+                        std::forward<decltype(args)>(args)...};
+                }
+            });
+    }
+};
+
+template <typename T, typename E>
+    requires(!std::is_reference_v<T> && !std::is_reference_v<E> &&
+             detail::is_serializable_v<T> && detail::is_serializable_v<E>)
+struct codec<result<T, E>> {
+    static void encode(byte_writer auto& writer, const result<T, E>& value) {
+        detail::write_varint(writer, value.has_value() ? 0U : 1U);
+        if (value.has_value()) {
+            if constexpr (!std::is_void_v<T>) { codec<T>::encode(writer, *value); }
+        } else {
+            if constexpr (!std::is_void_v<E>) { codec<E>::encode(writer, value.error()); }
+        }
+    }
+
+    static result<result<T, E>, decode_error> decode(byte_reader auto& reader) {
+        return detail::decode_alternative<result<T, E>, T, E>(
+            reader, std::array<uint64_t, 2>{0, 1}, [](auto inplace, auto&&... args) {
+                return result<result<T, E>, decode_error>{
+                    std::in_place, inplace, std::forward<decltype(args)>(args)...};
+            });
+    }
+};
+
+#endif
+
+} // namespace sumty
+
+#endif
@@ -0,0 +1,199 @@
+/* Copyright 2024 Jack A Bernard Jr.
+ *
+ * Licensed under the Apache License, Version 2.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SUMTY_SHARED_VARIANT_HPP
+#define SUMTY_SHARED_VARIANT_HPP
+
+#include "sumty/variant.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace sumty {
+
+/// @class shared_variant shared_variant.hpp <sumty/shared_variant.hpp>
+/// @brief Copy-on-write, reference counted @ref variant
+///
+/// @details
+/// @ref shared_variant holds a @ref variant in a single heap allocated
+/// control block, together with an atomic reference count. Copying a
+/// @ref shared_variant only increments the reference count, so large values,
+/// such as configuration snapshots or routing tables, can be handed to any
+/// number of readers in constant time and without additional memory.
+///
+/// The value is immutable while it is shared. Mutation through
+/// @ref visit_mut or @ref make_mut first checks if this @ref shared_variant
+/// is the only owner of the value, and if not, copies the value into a new
+/// control block that it owns alone. Other owners are unaffected.
+///
+/// Copies of a @ref shared_variant may be used and destroyed concurrently
+/// from different threads, but, as with `std::shared_ptr`, a single
+/// @ref shared_variant object must not be modified concurrently with any
+/// other access to that same object.
+///
+/// A moved-from @ref shared_variant does not own a value, and may only be
+/// assigned to or destroyed.
+///
+/// ## Example
+/// ```cpp
+/// struct routes { std::vector<route> table; };
+/// struct draining {};
+///
+/// shared_variant<routes, draining> current{routes{load_routes()}};
+///
+/// // O(1) fan-out to readers
+/// for (auto& worker : workers) { worker.post(current); }
+///
+/// // copies the table only if a reader still holds it
+/// current.visit_mut(overload(
+///     [](routes& r) { r.table.push_back(extra_route); },
+///     [](draining&) {}
+/// ));
+/// ```
+///
+/// @tparam T The alternative types of the contained @ref variant
+template <typename... T>
+class shared_variant {
+  private:
+    struct block {
+        std::atomic<size_t> refs;
+        variant<T...> value;
+
+        template <typename... Args>
+        explicit block(Args&&... args) : refs(1), value(std::forward<Args>(args)...) {}
+    };
+
+    block* block_;
+
+    void release() noexcept {
+        if (block_ == nullptr) { return; }
+        if (block_->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) { delete block_; }
+    }
+
+  public:
+    using value_type = variant<T...>;
+
+    /// @brief Constructs a @ref shared_variant holding a default constructed
+    /// first alternative
+    shared_variant() : block_(new block()) {}
+
+    /// @brief Constructs a @ref shared_variant holding a copy of `value`
+    // NOLINTNEXTLINE(hicpp-explicit-conversions)
+    shared_variant(const variant<T...>& value) : block_(new block(value)) {}
+
+    /// @brief Constructs a @ref shared_variant by moving from `value`
+    // NOLINTNEXTLINE(hicpp-explicit-conversions)
+    shared_variant(variant<T...>&& value) : block_(new block(std::move(value))) {}
+
+    /// @brief Constructs a @ref shared_variant holding the alternative at
+    /// index `IDX`, constructed in place
+    template <size_t IDX, typename... Args>
+    explicit shared_variant(std::in_place_index_t<IDX> inplace, Args&&... args)
+        : block_(new block(inplace, std::forward<Args>(args)...)) {}
+
+    /// @brief Copy constructor
+    ///
+    /// @details
+    /// The new @ref shared_variant shares the value of `other`.
+    shared_variant(const shared_variant& other) noexcept : block_(other.block_) {
+        if (block_ != nullptr) { block_->refs.fetch_add(1, std::memory_order_relaxed); }
+    }
+
+    /// @brief Move constructor
+    shared_variant(shared_variant&& other) noexcept
+        : block_(std::exchange(other.block_, nullptr)) {}
+
+    ~shared_variant() noexcept { release(); }
+
+    /// @brief Copy assignment operator
+    shared_variant& operator=(const shared_variant& rhs) noexcept {
+        if (block_ != rhs.block_) {
+            release();
+            block_ = rhs.block_;
+            if (block_ != nullptr) { block_->refs.fetch_add(1, std::memory_order_relaxed); }
+        }
+        return *this;
+    }
+
+    /// @brief Move assignment operator
+    shared_variant& operator=(shared_variant&& rhs) noexcept {
+        if (this != &rhs) {
+            release();
+            block_ = std::exchange(rhs.block_, nullptr);
+        }
+        return *this;
+    }
+
+    /// @brief Gets a reference to the shared value
+    [[nodiscard]] const variant<T...>& get() const noexcept { return block_->value; }
+
+    /// @brief Gets a reference to the shared value
+    [[nodiscard]] const variant<T...>& operator*() const noexcept { return block_->value; }
+
+    /// @brief Accesses members of the shared value
+    const variant<T...>* operator->() const noexcept { return &block_->value; }
+
+    /// @brief Gets the index of the alternative of the shared value
+    [[nodiscard]] size_t index() const noexcept { return block_->value.index(); }
+
+    /// @brief Gets the number of @ref shared_variant objects that share the
+    /// value
+    ///
+    /// @details
+    /// In the presence of other threads, the result is only a snapshot.
+    [[nodiscard]] size_t use_count() const noexcept {
+        return block_ == nullptr ? 0 : block_->refs.load(std::memory_order_relaxed);
+    }
+
+    /// @brief Checks if this @ref shared_variant is the only owner of its
+    /// value
+    [[nodiscard]] bool unique() const noexcept {
+        return block_ != nullptr && block_->refs.load(std::memory_order_acquire) == 1;
+    }
+
+    /// @brief Calls a visitor with the alternative of the shared value
+    template <typename V>
+    decltype(auto) visit(V&& visitor) const {
+        return block_->value.visit(std::forward<V>(visitor));
+    }
+
+    /// @brief Gets a mutable reference to the value, copying it first if it
+    /// is shared
+    ///
+    /// @details
+    /// The reference is invalidated by copying this @ref shared_variant.
+    [[nodiscard]] variant<T...>& make_mut() {
+        if (!unique()) {
+            auto* owned = new block(std::as_const(block_->value));
+            release();
+            block_ = owned;
+        }
+        return block_->value;
+    }
+
+    /// @brief Calls a visitor with the mutable alternative of the value,
+    /// copying it first if it is shared
+    template <typename V>
+    decltype(auto) visit_mut(V&& visitor) {
+        return detail::visit_impl<V, variant<T...>&, T...>(std::forward<V>(visitor),
+                                                            make_mut());
+    }
+};
+
+} // namespace sumty
+
+#endif
@@ -0,0 +1,542 @@
+/* Copyright 2024 Jack A Bernard Jr.
+ *
+ * Licensed under the Apache License, Version 2.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SUMTY_TASK_HPP
+#define SUMTY_TASK_HPP
+
+#include "sumty/detail/utils.hpp"
+#include "sumty/oneshot.hpp"
+#include "sumty/option.hpp"
+#include "sumty/result.hpp"
+
+#include <algorithm>
+#include <array>
+#include <condition_variable>
+#include <coroutine>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace sumty {
+
+template <typename T, typename E>
+class task;
+
+namespace detail {
+
+// Thread-local cache of coroutine frames, bucketed by size. Frames are
+// returned to the cache of the thread that frees them, rather than to the
+// global heap, so that steady-state coroutine creation does not allocate.
+class frame_allocator {
+  private:
+    static constexpr size_t granularity = 64;
+    static constexpr size_t bucket_count = 16;
+    static constexpr size_t max_cached = 64;
+
+    struct free_frame {
+        free_frame* next;
+    };
+
+    struct cache {
+        std::array<free_frame*, bucket_count> heads{};
+        std::array<size_t, bucket_count> counts{};
+
+        cache() noexcept = default;
+        cache(const cache&) = delete;
+        cache(cache&&) = delete;
+        cache& operator=(const cache&) = delete;
+        cache& operator=(cache&&) = delete;
+
+        ~cache() noexcept {
+            for (size_t i = 0; i < bucket_count; ++i) {
+                while (heads[i] != nullptr) {
+                    ::operator delete(std::exchange(heads[i], heads[i]->next),
+                                      (i + 1) * granularity);
+                }
+            }
+        }
+    };
+
+    static cache& local() noexcept {
+        thread_local cache frames{};
+        return frames;
+    }
+
+  public:
+    [[nodiscard]] static void* allocate(size_t size) {
+        const size_t bucket = (size - 1) / granularity;
+        if (bucket >= bucket_count) { return ::operator new(size); }
+        auto& frames = local();
+        if (frames.heads[bucket] != nullptr) {
+            --frames.counts[bucket];
+            return std::exchange(frames.heads[bucket], frames.heads[bucket]->next);
+        }
+        return ::operator new((bucket + 1) * granularity);
+    }
+
+    static void deallocate(void* ptr, size_t size) noexcept {
+        const size_t bucket = (size - 1) / granularity;
+        if (bucket >= bucket_count) {
+            ::operator delete(ptr, size);
+            return;
+        }
+        auto& frames = local();
+        if (frames.counts[bucket] == max_cached) {
+            ::operator delete(ptr, (bucket + 1) * granularity);
+            return;
+        }
+        ++frames.counts[bucket];
+        frames.heads[bucket] = ::new (ptr) free_frame{frames.heads[bucket]};
+    }
+};
+
+struct frame_allocated {
+    static void* operator new(size_t size) { return frame_allocator::allocate(size); }
+
+    static void operator delete(void* ptr, size_t size) noexcept {
+        frame_allocator::deallocate(ptr, size);
+    }
+};
+
+// Awaiter for a result that is awaited in a task. An error completes the
+// awaiting task with that error, and resumes its continuation, without
+// resuming the awaiting task. The result is bound by reference, since even a
+// temporary result lives until the end of the full-expression containing the
+// co_await.
+template <typename R>
+class propagate_awaiter {
+  private:
+    using result_t = std::remove_cvref_t<R>;
+
+    R res_;
+
+  public:
+    explicit propagate_awaiter(R res) noexcept : res_(std::forward<R>(res)) {}
+
+    [[nodiscard]] bool await_ready() const noexcept { return res_.has_value(); }
+
+    template <typename P>
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<P> handle) {
+        return handle.promise().propagate(std::forward<R>(res_).error());
+    }
+
+    typename result_t::value_type await_resume() {
+        if constexpr (std::is_void_v<typename result_t::value_type>) {
+            return;
+        } else {
+            return *std::forward<R>(res_);
+        }
+    }
+};
+
+template <typename T, typename E>
+class task_promise : public frame_allocated {
+  private:
+    std::coroutine_handle<> continuation_{std::noop_coroutine()};
+    option<result<T, E>> result_{};
+    std::exception_ptr exception_{};
+
+    struct final_awaiter {
+        [[nodiscard]] bool await_ready() const noexcept { return false; }
+
+        std::coroutine_handle<> await_suspend(
+            std::coroutine_handle<task_promise> handle) noexcept {
+            return handle.promise().continuation_;
+        }
+
+        void await_resume() const noexcept {}
+    };
+
+  public:
+    task<T, E> get_return_object() noexcept;
+
+    std::suspend_always initial_suspend() const noexcept { return {}; }
+
+    final_awaiter final_suspend() const noexcept { return {}; }
+
+    void return_value(result<T, E> res) { result_.emplace(std::move(res)); }
+
+    void unhandled_exception() noexcept { exception_ = std::current_exception(); }
+
+    template <typename A>
+    decltype(auto) await_transform(A&& awaitable) {
+        if constexpr (is_result_v<std::remove_cvref_t<A>>) {
+            return propagate_awaiter<A&&>(std::forward<A>(awaitable));
+        } else {
+            return std::forward<A>(awaitable);
+        }
+    }
+
+    template <typename U>
+    std::coroutine_handle<> propagate(U&& err) {
+        result_.emplace(in_place_error, std::forward<U>(err));
+        return continuation_;
+    }
+
+    void set_continuation(std::coroutine_handle<> continuation) noexcept {
+        continuation_ = continuation;
+    }
+
+    result<T, E> take() {
+        if (exception_) { std::rethrow_exception(exception_); }
+        return *std::move(result_);
+    }
+};
+
+// Fire-and-forget coroutine that is used to start a task from outside of a
+// coroutine. The frame destroys itself when the coroutine finishes.
+struct detached {
+    struct promise_type : frame_allocated {
+        detached get_return_object() const noexcept { return {}; }
+
+        std::suspend_never initial_suspend() const noexcept { return {}; }
+
+        std::suspend_never final_suspend() const noexcept { return {}; }
+
+        void return_void() const noexcept {}
+
+        [[noreturn]] void unhandled_exception() const noexcept { std::terminate(); }
+    };
+};
+
+template <typename T, typename E, typename F>
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-reference-coroutine-parameters)
+detached drive(task<T, E> tsk, F on_done) {
+    on_done(co_await std::move(tsk));
+}
+
+template <typename Ex>
+struct schedule_awaiter {
+    Ex* executor;
+
+    [[nodiscard]] bool await_ready() const noexcept { return false; }
+
+    void await_suspend(std::coroutine_handle<> handle) const { executor->post(handle); }
+
+    void await_resume() const noexcept {}
+};
+
+} // namespace detail
+
+/// @class task task.hpp <sumty/task.hpp>
+/// @brief Lazily started coroutine that produces a @ref result
+///
+/// @details
+/// A coroutine that returns @ref task completes with a @ref result,
+/// returned with `co_return`. A @ref task does not start running until it
+/// is awaited. Awaiting a @ref task evaluates to its @ref result, so errors
+/// are passed along as values rather than as exceptions.
+///
+/// Inside of a @ref task coroutine, awaiting a @ref result propagates its
+/// error: if the @ref result holds a value, `co_await` evaluates to that
+/// value, and otherwise the @ref task immediately completes with the error,
+/// like the `?` operator in Rust. Thus, `co_await co_await child()` awaits a
+/// child @ref task and propagates its error.
+///
+/// When a @ref task completes, the awaiting coroutine is resumed with
+/// symmetric transfer, so arbitrarily long chains of synchronously
+/// completing tasks do not grow the stack. Coroutine frames are allocated
+/// from a thread-local cache of recycled frames.
+///
+/// An exception that escapes the coroutine is rethrown when the @ref task is
+/// awaited.
+///
+/// ## Example
+/// ```cpp
+/// task<std::string> load(std::string_view key);
+///
+/// task<size_t> total_size(std::string_view a, std::string_view b) {
+///     std::string va = co_await co_await load(a);
+///     std::string vb = co_await co_await load(b);
+///     co_return va.size() + vb.size();
+/// }
+///
+/// thread_pool_executor pool{4};
+/// result<size_t> res = sync_wait(total_size("a", "b"));
+/// ```
+///
+/// @tparam T The value type of the @ref result
+/// @tparam E The error type of the @ref result
+template <typename T, typename E = std::error_code>
+class [[nodiscard]] task {
+  public:
+    using promise_type = detail::task_promise<T, E>;
+    using value_type = T;
+    using error_type = E;
+
+  private:
+    std::coroutine_handle<promise_type> handle_;
+
+    explicit task(std::coroutine_handle<promise_type> handle) noexcept : handle_(handle) {}
+
+    friend promise_type;
+
+    struct awaiter {
+        std::coroutine_handle<promise_type> handle;
+
+        [[nodiscard]] bool await_ready() const noexcept { return false; }
+
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<> parent) noexcept {
+            handle.promise().set_continuation(parent);
+            return handle;
+        }
+
+        result<T, E> await_resume() { return handle.promise().take(); }
+    };
+
+  public:
+    task(const task&) = delete;
+
+    task(task&& other) noexcept : handle_(std::exchange(other.handle_, nullptr)) {}
+
+    ~task() noexcept {
+        if (handle_) { handle_.destroy(); }
+    }
+
+    task& operator=(const task&) = delete;
+
+    task& operator=(task&& rhs) noexcept {
+        if (this != &rhs) {
+            if (handle_) { handle_.destroy(); }
+            handle_ = std::exchange(rhs.handle_, nullptr);
+        }
+        return *this;
+    }
+
+    /// @brief Starts the @ref task and suspends the awaiting coroutine until
+    /// it completes
+    ///
+    /// @details
+    /// A @ref task can only be awaited as an rvalue, as in
+    /// `co_await std::move(tsk)`, since it can only be awaited once. Awaiting
+    /// a @ref task that has already been awaited, or that has been moved
+    /// from, is undefined behavior.
+    ///
+    /// @return The @ref result of the @ref task
+    awaiter operator co_await() && noexcept { return awaiter{handle_}; }
+};
+
+template <typename T, typename E>
+task<T, E> detail::task_promise<T, E>::get_return_object() noexcept {
+    return task<T, E>(std::coroutine_handle<task_promise>::from_promise(*this));
+}
+
+/// @relates task
+/// @brief Runs a @ref task to completion, blocking the calling thread
+///
+/// @details
+/// The @ref task starts running on the calling thread, and continues on
+/// whichever executors it schedules itself onto. If an exception escapes
+/// the @ref task, `std::terminate` is called.
+template <typename T, typename E>
+[[nodiscard]] result<T, E> sync_wait(task<T, E> tsk) {
+    // The channel is shared with the driver, which may still be unwinding on
+    // another thread when the waiting thread returns.
+    auto done = std::make_shared<oneshot<T, E>>();
+    detail::drive(std::move(tsk), [done](result<T, E>&& res) {
+        static_cast<void>(done->set(std::move(res)));
+    });
+    return done->wait();
+}
+
+/// @class single_thread_executor task.hpp <sumty/task.hpp>
+/// @brief Executor that resumes coroutines on a single thread that drives it
+///
+/// @details
+/// Coroutines are scheduled onto the executor by awaiting @ref schedule,
+/// which may be done from any thread. They are resumed, in order, by the
+/// thread that calls @ref run or @ref block_on.
+///
+/// ## Example
+/// ```cpp
+/// single_thread_executor loop{};
+///
+/// task<int> work(single_thread_executor& exec) {
+///     co_await exec.schedule();
+///     co_return 42;
+/// }
+///
+/// result<int> res = loop.block_on(work(loop));
+/// ```
+class single_thread_executor {
+  private:
+    std::mutex mtx_{};
+    std::condition_variable cv_{};
+    std::deque<std::coroutine_handle<>> queue_{};
+
+  public:
+    single_thread_executor() = default;
+
+    single_thread_executor(const single_thread_executor&) = delete;
+
+    single_thread_executor& operator=(const single_thread_executor&) = delete;
+
+    ~single_thread_executor() noexcept = default;
+
+    /// @brief Returns an awaitable that suspends the awaiting coroutine and
+    /// resumes it on this executor
+    [[nodiscard]] detail::schedule_awaiter<single_thread_executor> schedule() noexcept {
+        return {this};
+    }
+
+    /// @brief Queues a coroutine to be resumed on this executor
+    void post(std::coroutine_handle<> handle) {
+        // Notifying under the lock keeps the executor alive until the
+        // notification is done, because the resumed coroutine may lead to
+        // the executor being destroyed.
+        const std::lock_guard lock{mtx_};
+        queue_.push_back(handle);
+        cv_.notify_one();
+    }
+
+    /// @brief Resumes queued coroutines on the calling thread until the queue
+    /// is empty
+    ///
+    /// @return The number of coroutines that were resumed
+    size_t run() {
+        size_t count = 0;
+        std::unique_lock lock{mtx_};
+        while (!queue_.empty()) {
+            auto handle = queue_.front();
+            queue_.pop_front();
+            lock.unlock();
+            handle.resume();
+            ++count;
+            lock.lock();
+        }
+        return count;
+    }
+
+    /// @brief Runs a @ref task to completion on the calling thread
+    ///
+    /// @details
+    /// Queued coroutines are resumed on the calling thread until the
+    /// @ref task completes. If the queue is empty while the @ref task is
+    /// still waiting on another thread, the calling thread blocks until
+    /// more work is queued. If an exception escapes the @ref task,
+    /// `std::terminate` is called.
+    template <typename T, typename E>
+    [[nodiscard]] result<T, E> block_on(task<T, E> tsk) {
+        option<result<T, E>> out{};
+        bool finished = false;
+        detail::drive(std::move(tsk), [this, &out, &finished](result<T, E>&& res) {
+            out.emplace(std::move(res));
+            const std::lock_guard lock{mtx_};
+            finished = true;
+            cv_.notify_one();
+        });
+        std::unique_lock lock{mtx_};
+        for (;;) {
+            cv_.wait(lock, [this, &finished] { return finished || !queue_.empty(); });
+            if (finished) { break; }
+            auto handle = queue_.front();
+            queue_.pop_front();
+            lock.unlock();
+            handle.resume();
+            lock.lock();
+        }
+        return *std::move(out);
+    }
+};
+
+/// @class thread_pool_executor task.hpp <sumty/task.hpp>
+/// @brief Executor that resumes coroutines on a fixed pool of threads
+///
+/// @details
+/// Coroutines are scheduled onto the pool by awaiting @ref schedule. When
+/// the executor is destroyed, the coroutines that are already queued are
+/// resumed before the threads exit.
+///
+/// ## Example
+/// ```cpp
+/// thread_pool_executor pool{4};
+///
+/// task<int> work(thread_pool_executor& exec) {
+///     co_await exec.schedule();
+///     co_return 42;
+/// }
+///
+/// result<int> res = sync_wait(work(pool));
+/// ```
+class thread_pool_executor {
+  private:
+    std::mutex mtx_{};
+    std::condition_variable cv_{};
+    std::deque<std::coroutine_handle<>> queue_{};
+    bool stopping_{false};
+    std::vector<std::thread> workers_{};
+
+    void work() {
+        std::unique_lock lock{mtx_};
+        for (;;) {
+            cv_.wait(lock, [this] { return stopping_ || !queue_.empty(); });
+            if (queue_.empty()) { return; }
+            auto handle = queue_.front();
+            queue_.pop_front();
+            lock.unlock();
+            handle.resume();
+            lock.lock();
+        }
+    }
+
+  public:
+    /// @brief Constructs a @ref thread_pool_executor with `threads` worker
+    /// threads
+    explicit thread_pool_executor(
+        size_t threads = std::max<size_t>(std::thread::hardware_concurrency(), 1)) {
+        workers_.reserve(threads);
+        for (size_t i = 0; i < threads; ++i) {
+            workers_.emplace_back([this] { work(); });
+        }
+    }
+
+    thread_pool_executor(const thread_pool_executor&) = delete;
+
+    thread_pool_executor& operator=(const thread_pool_executor&) = delete;
+
+    ~thread_pool_executor() noexcept {
+        {
+            const std::lock_guard lock{mtx_};
+            stopping_ = true;
+        }
+        cv_.notify_all();
+        for (auto& worker : workers_) { worker.join(); }
+    }
+
+    /// @brief Returns an awaitable that suspends the awaiting coroutine and
+    /// resumes it on one of the pool threads
+    [[nodiscard]] detail::schedule_awaiter<thread_pool_executor> schedule() noexcept {
+        return {this};
+    }
+
+    /// @brief Queues a coroutine to be resumed on one of the pool threads
+    void post(std::coroutine_handle<> handle) {
+        const std::lock_guard lock{mtx_};
+        queue_.push_back(handle);
+        cv_.notify_one();
+    }
+};
+
+} // namespace sumty
+
+#endif
@@ -0,0 +1,186 @@
+/* Copyright 2024 Jack A Bernard Jr.
+ *
+ * Licensed under the Apache License, Version 2.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SUMTY_TLS_ERROR_HPP
+#define SUMTY_TLS_ERROR_HPP
+
+#include "sumty/option.hpp"
+#include "sumty/utils.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+namespace sumty {
+
+namespace detail {
+
+template <typename E, size_t N>
+struct tls_error_ring {
+    // An id holds the tag of the ring that created it in the high bits and
+    // the ring's own sequence number in the low bits. The low bits select the
+    // slot, and the tag keeps ids created on other threads from matching.
+    static constexpr uint32_t seq_bits = 16;
+    static constexpr uint32_t seq_mask = (uint32_t{1} << seq_bits) - 1;
+
+    struct slot {
+        uint32_t id{0};
+        option<E> error{};
+    };
+
+    std::array<slot, N> slots{};
+    uint32_t tag{next_tag()};
+    uint32_t seq{0};
+
+    [[nodiscard]] static uint32_t next_tag() noexcept {
+        static std::atomic<uint32_t> counter{0};
+        uint32_t t = 0;
+        // tag zero is reserved, so that id zero marks slots that were never used
+        while (t == 0) { t = counter.fetch_add(1, std::memory_order_relaxed) & seq_mask; }
+        return t << seq_bits;
+    }
+
+    [[nodiscard]] static tls_error_ring& get() noexcept {
+        static thread_local tls_error_ring ring{};
+        return ring;
+    }
+
+    [[nodiscard]] slot& at(uint32_t id) noexcept { return slots[id & (N - 1)]; }
+
+    template <typename... Args>
+    [[nodiscard]] uint32_t store(Args&&... args) {
+        const uint32_t id = tag | (seq++ & seq_mask);
+        auto& s = at(id);
+        s.id = 0;
+        s.error.emplace(std::forward<Args>(args)...);
+        s.id = id;
+        return id;
+    }
+};
+
+} // namespace detail
+
+/// @class tls_error tls_error.hpp <sumty/tls_error.hpp>
+/// @brief Error handle that keeps the error value in thread-local storage
+///
+/// @details
+/// Using a large error type with @ref result makes every @ref result at
+/// least as large as the error type, even though errors are usually rare.
+/// Using @ref tls_error as the error type of a @ref result instead keeps the
+/// error value in a thread-local ring of `N` slots, and only stores a 32-bit
+/// slot id in the @ref result. A `result<int, tls_error<E>>` is therefore the
+/// same size as a `result<int, uint32_t>`, regardless of the size of `E`.
+///
+/// Creating a @ref tls_error stores the error in the next slot of the ring
+/// owned by the current thread, overwriting the oldest error. The error
+/// remains accessible until `N` more errors of the same type (and same `N`)
+/// have been created on the same thread. @ref valid can be used to check
+/// whether the error has been overwritten, as long as fewer than 2^16 errors
+/// of that type have been created on the thread since. Because the ring is
+/// owned by the creating thread, a @ref tls_error must not be dereferenced on
+/// another thread. Each id is tagged with the ring that created it, so @ref valid
+/// returns `false` and @ref get returns none when called on any thread other
+/// than the creator.
+///
+/// @ref tls_error is trivially copyable. Copies refer to the same slot.
+///
+/// ## Example
+/// ```cpp
+/// struct big_error {
+///     std::array<char, 256> message;
+/// };
+///
+/// result<int, tls_error<big_error>> fallible(bool fail) {
+///     if (fail) { return error<big_error>(); }
+///     return 42;
+/// }
+///
+/// static_assert(sizeof(fallible(false)) == 8);
+///
+/// auto res = fallible(true);
+/// assert(res.error().valid());
+/// big_error& err = *res.error();
+/// ```
+///
+/// @tparam E The error type
+/// @tparam N The number of thread-local slots, which must be a power of two
+template <typename E, size_t N = 16>
+class tls_error {
+  private:
+    using ring_t = detail::tls_error_ring<E, N>;
+
+    static_assert(std::is_object_v<E> && !std::is_const_v<E>,
+                  "tls_error error type must be a non-const object type");
+    static_assert(N > 0 && (N & (N - 1)) == 0,
+                  "tls_error slot count must be a power of two");
+    static_assert(N <= (size_t{1} << 15), "tls_error slot count must be at most 2^15");
+
+    uint32_t id_;
+
+  public:
+    using value_type = E;
+
+    /// @brief Stores an error, constructed in place from `args`, in the next
+    /// thread-local slot.
+    template <typename... Args>
+    explicit tls_error([[maybe_unused]] std::in_place_t inplace, Args&&... args)
+        : id_(ring_t::get().store(std::forward<Args>(args)...)) {}
+
+    /// @brief Stores a copy of an error in the next thread-local slot.
+    // NOLINTNEXTLINE(hicpp-explicit-conversions)
+    tls_error(const E& error) : id_(ring_t::get().store(error)) {}
+
+    /// @brief Moves an error into the next thread-local slot.
+    // NOLINTNEXTLINE(hicpp-explicit-conversions)
+    tls_error(E&& error) : id_(ring_t::get().store(std::move(error))) {}
+
+    /// @brief Checks if the error is still stored in its slot
+    ///
+    /// @details
+    /// Returns `false` if the slot has since been reused for a newer error, or
+    /// if called on a thread other than the one that created the error.
+    [[nodiscard]] bool valid() const noexcept { return ring_t::get().at(id_).id == id_; }
+
+    /// @brief Gets the id of the slot the error was stored in
+    [[nodiscard]] constexpr uint32_t id() const noexcept { return id_; }
+
+    /// @brief Accesses the error
+    ///
+    /// @details
+    /// Accessing an error that is no longer @ref valid is undefined behavior.
+    [[nodiscard]] E& operator*() const noexcept { return *ring_t::get().at(id_).error; }
+
+    /// @brief Accesses the error
+    ///
+    /// @details
+    /// Accessing an error that is no longer @ref valid is undefined behavior.
+    [[nodiscard]] E* operator->() const noexcept {
+        return ring_t::get().at(id_).error.operator->();
+    }
+
+    /// @brief Gets a copy of the error, if it is still stored in its slot
+    [[nodiscard]] option<E> get() const {
+        auto& slot = ring_t::get().at(id_);
+        if (slot.id == id_) { return *slot.error; }
+        return none;
+    }
+};
+
+} // namespace sumty
+
+#endif
@@ -25,6 +25,12 @@
 #define SUMTY_NO_UNIQ_ADDR [[no_unique_address]]
 #endif
 
+#if defined(_MSC_VER) && !defined(__clang__)
+#define SUMTY_COLD __declspec(noinline)
+#else
+#define SUMTY_COLD [[gnu::cold, gnu::noinline]]
+#endif
+
 namespace sumty {
 
 using std::in_place_index_t;
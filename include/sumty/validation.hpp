@@ -0,0 +1,793 @@
+/* Copyright 2023 Jack A Bernard Jr.
+ *
+ * Licensed under the Apache License, Version 2.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SUMTY_VALIDATION_HPP
+#define SUMTY_VALIDATION_HPP
+
+#include "sumty/detail/fwd.hpp"    // IWYU pragma: export
+#include "sumty/detail/traits.hpp" // IWYU pragma: export
+#include "sumty/detail/utils.hpp"
+#include "sumty/exceptions.hpp"
+#include "sumty/result.hpp"
+#include "sumty/utils.hpp" // IWYU pragma: export
+#include "sumty/variant.hpp"
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace sumty {
+
+/// @class error_list validation.hpp <sumty/validation.hpp>
+/// @brief Sequence of errors with inline storage for the first `N` errors
+///
+/// @details
+/// @ref error_list is the error container used by @ref validation. The first
+/// `N` errors are stored inside the @ref error_list object itself, so
+/// accumulating up to `N` errors never allocates. Appending beyond `N` errors
+/// moves all errors to a heap allocated buffer that grows geometrically.
+///
+/// ## Example
+/// ```cpp
+/// error_list<std::string_view, 2> errs;
+///
+/// errs.push_back("first");
+/// errs.push_back("second");
+///
+/// assert(errs.size() == 2);
+/// assert(errs.is_inline());
+/// ```
+///
+/// @tparam E The error type
+/// @tparam N The number of errors stored inline
+template <typename E, size_t N>
+class error_list {
+  private:
+    static_assert(std::is_object_v<E> && !std::is_const_v<E>,
+                  "error_list error type must be a non-const object type");
+    static_assert(N > 0, "error_list must have an inline capacity of at least one");
+
+    union storage {
+        // NOLINTNEXTLINE(modernize-use-equals-default)
+        constexpr storage() noexcept {}
+        // NOLINTNEXTLINE(modernize-use-equals-default)
+        constexpr ~storage() noexcept {}
+
+        // NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays,hicpp-avoid-c-arrays)
+        E items[N];
+    };
+
+    storage inline_;
+    E* heap_{nullptr};
+    size_t size_{0};
+    size_t cap_{N};
+
+    [[nodiscard]] E* inline_data() noexcept { return inline_.items; }
+
+    [[nodiscard]] const E* inline_data() const noexcept { return inline_.items; }
+
+    void release() noexcept {
+        std::destroy_n(data(), size_);
+        if (heap_ != nullptr) {
+            std::allocator<E>{}.deallocate(heap_, cap_);
+            heap_ = nullptr;
+        }
+        size_ = 0;
+        cap_ = N;
+    }
+
+    void steal(error_list& other) noexcept(std::is_nothrow_move_constructible_v<E>) {
+        if (other.heap_ != nullptr) {
+            heap_ = std::exchange(other.heap_, nullptr);
+            cap_ = std::exchange(other.cap_, N);
+            size_ = std::exchange(other.size_, 0);
+        } else {
+            std::uninitialized_move_n(other.inline_data(), other.size_, inline_data());
+            size_ = other.size_;
+            other.clear();
+        }
+    }
+
+    template <typename... Args>
+    E& grow_and_emplace(Args&&... args) {
+        const size_t new_cap = cap_ * 2;
+        E* new_data = std::allocator<E>{}.allocate(new_cap);
+        try {
+            // The new error is constructed first, because the arguments may
+            // refer to an error that is already in the list.
+            std::construct_at(new_data + size_, std::forward<Args>(args)...);
+        } catch (...) {
+            std::allocator<E>{}.deallocate(new_data, new_cap);
+            throw;
+        }
+        try {
+            // Existing errors are copied instead of moved when a throwing move
+            // could otherwise leave the list half moved from.
+            if constexpr (std::is_nothrow_move_constructible_v<E> ||
+                          !std::is_copy_constructible_v<E>) {
+                std::uninitialized_move_n(data(), size_, new_data);
+            } else {
+                std::uninitialized_copy_n(data(), size_, new_data);
+            }
+        } catch (...) {
+            std::destroy_at(new_data + size_);
+            std::allocator<E>{}.deallocate(new_data, new_cap);
+            throw;
+        }
+        const size_t new_size = size_ + 1;
+        release();
+        heap_ = new_data;
+        cap_ = new_cap;
+        size_ = new_size;
+        return heap_[size_ - 1];
+    }
+
+  public:
+    using value_type = E;
+    using size_type = size_t;
+    using reference = E&;
+    using const_reference = const E&;
+    using pointer = E*;
+    using const_pointer = const E*;
+    using iterator = E*;
+    using const_iterator = const E*;
+
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-member-init,hicpp-member-init)
+    error_list() noexcept {}
+
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-member-init,hicpp-member-init)
+    error_list(const error_list& other) {
+        for (const auto& err : other) { emplace_back(err); }
+    }
+
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-member-init,hicpp-member-init)
+    error_list(error_list&& other) noexcept(std::is_nothrow_move_constructible_v<E>) {
+        steal(other);
+    }
+
+    ~error_list() noexcept { release(); }
+
+    error_list& operator=(const error_list& rhs) {
+        if (this != &rhs) {
+            clear();
+            for (const auto& err : rhs) { emplace_back(err); }
+        }
+        return *this;
+    }
+
+    error_list& operator=(error_list&& rhs) noexcept(
+        std::is_nothrow_move_constructible_v<E>) {
+        if (this != &rhs) {
+            release();
+            steal(rhs);
+        }
+        return *this;
+    }
+
+    [[nodiscard]] size_t size() const noexcept { return size_; }
+
+    [[nodiscard]] bool empty() const noexcept { return size_ == 0; }
+
+    [[nodiscard]] size_t capacity() const noexcept { return cap_; }
+
+    /// @brief Checks if the errors are stored inside the @ref error_list
+    ///
+    /// @details
+    /// Returns `true` until more than `N` errors have been appended, after
+    /// which the errors live in a heap allocation.
+    [[nodiscard]] bool is_inline() const noexcept { return heap_ == nullptr; }
+
+    [[nodiscard]] E* data() noexcept { return heap_ != nullptr ? heap_ : inline_data(); }
+
+    [[nodiscard]] const E* data() const noexcept {
+        return heap_ != nullptr ? heap_ : inline_data();
+    }
+
+    [[nodiscard]] iterator begin() noexcept { return data(); }
+
+    [[nodiscard]] const_iterator begin() const noexcept { return data(); }
+
+    [[nodiscard]] iterator end() noexcept { return data() + size_; }
+
+    [[nodiscard]] const_iterator end() const noexcept { return data() + size_; }
+
+    [[nodiscard]] E& operator[](size_t idx) noexcept { return data()[idx]; }
+
+    [[nodiscard]] const E& operator[](size_t idx) const noexcept { return data()[idx]; }
+
+    [[nodiscard]] E& front() noexcept { return data()[0]; }
+
+    [[nodiscard]] const E& front() const noexcept { return data()[0]; }
+
+    [[nodiscard]] E& back() noexcept { return data()[size_ - 1]; }
+
+    [[nodiscard]] const E& back() const noexcept { return data()[size_ - 1]; }
+
+    template <typename... Args>
+    E& emplace_back(Args&&... args) {
+        if (size_ == cap_) [[unlikely]] {
+            return grow_and_emplace(std::forward<Args>(args)...);
+        }
+        E* ptr = std::construct_at(data() + size_, std::forward<Args>(args)...);
+        ++size_;
+        return *ptr;
+    }
+
+    void push_back(const E& error) { emplace_back(error); }
+
+    void push_back(E&& error) { emplace_back(std::move(error)); }
+
+    /// @brief Appends copies of all errors from another @ref error_list
+    template <size_t M>
+    void append(const error_list<E, M>& other) {
+        for (const auto& err : other) { emplace_back(err); }
+    }
+
+    /// @brief Moves all errors from another @ref error_list to the end of
+    /// this one
+    template <size_t M>
+    void append(error_list<E, M>&& other) {
+        for (auto& err : other) { emplace_back(std::move(err)); }
+        other.clear();
+    }
+
+    /// @brief Destroys all contained errors
+    ///
+    /// @details
+    /// Any heap allocation is kept for reuse.
+    void clear() noexcept {
+        std::destroy_n(data(), size_);
+        size_ = 0;
+    }
+};
+
+/// @class validation validation.hpp <sumty/validation.hpp>
+/// @brief Result type that accumulates every error instead of the first one
+///
+/// @details
+/// A @ref validation either contains a value of type `T`, or a non-empty
+/// @ref error_list of errors of type `E`. Unlike @ref result, which
+/// represents at most one error, independent validations can be combined
+/// with @ref combine such that all of their errors are reported together.
+///
+/// Errors are stored in an @ref error_list with inline capacity for `N`
+/// errors, so reporting up to `N` errors does not allocate.
+///
+/// A @ref validation converts back to a @ref result with either
+/// @ref ok_or_errors, which keeps every error, or @ref ok_or_first_error,
+/// which keeps only the first error. Because `E` is commonly an
+/// @ref error_set, the latter composes with the implicit @ref error_set
+/// conversions of @ref result.
+///
+/// ## Example
+/// ```cpp
+/// validation<int, std::string> check_age(int age) {
+///     if (age < 0) { return error<std::string>("age is negative"); }
+///     return age;
+/// }
+///
+/// validation<std::string, std::string> check_name(std::string name) {
+///     if (name.empty()) { return error<std::string>("name is empty"); }
+///     return name;
+/// }
+///
+/// auto v = combine(check_age(-1), check_name(""));
+///
+/// assert(!v.has_value());
+/// assert(v.errors().size() == 2);
+/// ```
+///
+/// @tparam T The value type
+/// @tparam E The error type
+/// @tparam N The number of errors stored without allocating
+template <typename T, typename E, size_t N = 4>
+class validation {
+  private:
+    variant<T, error_list<E, N>> val_;
+
+    template <typename, typename, size_t>
+    friend class validation;
+
+  public:
+#ifndef DOXYGEN
+    using value_type = typename detail::traits<T>::value_type;
+    using reference = typename detail::traits<T>::reference;
+    using const_reference = typename detail::traits<T>::const_reference;
+    using rvalue_reference = typename detail::traits<T>::rvalue_reference;
+    using const_rvalue_reference = typename detail::traits<T>::const_rvalue_reference;
+    using pointer = typename detail::traits<T>::pointer;
+    using const_pointer = typename detail::traits<T>::const_pointer;
+#else
+    using value_type = ...;
+    using reference = ...;
+    using const_reference = ...;
+    using rvalue_reference = ...;
+    using const_rvalue_reference = ...;
+    using pointer = ...;
+    using const_pointer = ...;
+#endif
+
+    using error_type = E;
+    using error_list_type = error_list<E, N>;
+
+    constexpr validation()
+#ifndef DOXYGEN
+        noexcept(detail::traits<T>::is_nothrow_default_constructible)
+        requires(detail::traits<T>::is_default_constructible)
+    = default;
+#else
+        CONDITIONALLY_NOEXCEPT;
+#endif
+
+    constexpr validation(const validation&) = default;
+
+    constexpr validation(validation&&)
+#ifndef DOXYGEN
+        noexcept(std::is_nothrow_move_constructible_v<variant<T, error_list<E, N>>>)
+#else
+        CONDITIONALLY_NOEXCEPT
+#endif
+        = default;
+
+    template <typename... Args>
+#ifndef DOXYGEN
+    explicit(sizeof...(Args) == 0)
+#else
+    CONDITIONALLY_EXPLICIT
+#endif
+        // NOLINTNEXTLINE(hicpp-explicit-conversions)
+        constexpr validation([[maybe_unused]] std::in_place_t inplace, Args&&... args)
+        : val_(std::in_place_index<0>, std::forward<Args>(args)...) {
+    }
+
+    /// @brief Constructs an invalid @ref validation with a single error
+    /// constructed in place from `args`.
+    template <typename... Args>
+    constexpr validation([[maybe_unused]] in_place_error_t inplace, Args&&... args)
+        : val_(std::in_place_index<1>) {
+        val_[index<1>].emplace_back(std::forward<Args>(args)...);
+    }
+
+    /// @brief Constructs an invalid @ref validation from a list of errors
+    ///
+    /// @details
+    /// `errors` must not be empty.
+    explicit validation(error_list<E, N> errors) noexcept(
+        std::is_nothrow_move_constructible_v<E>)
+        : val_(std::in_place_index<1>, std::move(errors)) {}
+
+    template <typename U>
+#ifndef DOXYGEN
+        requires(detail::traits<T>::template is_constructible<U> &&
+                 !std::is_same_v<std::remove_cvref_t<U>, validation> &&
+                 !std::is_same_v<std::remove_cvref_t<U>, error_list<E, N>> &&
+                 !std::is_same_v<std::remove_cvref_t<U>, std::in_place_t> &&
+                 !std::is_same_v<std::remove_cvref_t<U>, in_place_error_t> &&
+                 !detail::is_error_v<std::remove_cvref_t<U>> &&
+                 !detail::is_ok_v<std::remove_cvref_t<U>> &&
+                 !detail::is_result_v<std::remove_cvref_t<U>>)
+    explicit(!detail::traits<T>::template is_convertible_from<U>)
+#else
+    CONDITIONALLY_EXPLICIT
+#endif
+        // NOLINTNEXTLINE(hicpp-explicit-conversions)
+        constexpr validation(U&& value)
+        : val_(std::in_place_index<0>, std::forward<U>(value)) {
+    }
+
+    template <typename U>
+    // NOLINTNEXTLINE(hicpp-explicit-conversions)
+    constexpr validation(ok_t<U> ok) : val_(std::in_place_index<0>, *std::move(ok)) {}
+
+    // NOLINTNEXTLINE(hicpp-explicit-conversions)
+    constexpr validation([[maybe_unused]] ok_t<void> ok) : val_(std::in_place_index<0>) {}
+
+    template <typename V>
+    // NOLINTNEXTLINE(hicpp-explicit-conversions)
+    constexpr validation(error_t<V> err) : val_(std::in_place_index<1>) {
+        val_[index<1>].emplace_back(*std::move(err));
+    }
+
+    /// @brief Converts a @ref result into a @ref validation
+    ///
+    /// @details
+    /// An error contained in the @ref result becomes the only error of the
+    /// new @ref validation.
+    template <typename U, typename V>
+#ifndef DOXYGEN
+        requires(!std::is_void_v<V>)
+#endif
+    // NOLINTNEXTLINE(hicpp-explicit-conversions)
+    constexpr validation(const result<U, V>& res) : val_(std::in_place_index<1>) {
+        if (res.has_value()) {
+            if constexpr (std::is_void_v<U>) {
+                val_.template emplace<0>();
+            } else {
+                val_.template emplace<0>(*res);
+            }
+        } else {
+            val_[index<1>].emplace_back(res.error());
+        }
+    }
+
+    template <typename U, typename V>
+#ifndef DOXYGEN
+        requires(!std::is_void_v<V>)
+#endif
+    // NOLINTNEXTLINE(hicpp-explicit-conversions)
+    constexpr validation(result<U, V>&& res) : val_(std::in_place_index<1>) {
+        if (res.has_value()) {
+            if constexpr (std::is_void_v<U>) {
+                val_.template emplace<0>();
+            } else {
+                val_.template emplace<0>(*std::move(res));
+            }
+        } else {
+            val_[index<1>].emplace_back(std::move(res).error());
+        }
+    }
+
+    constexpr ~validation() = default;
+
+    constexpr validation& operator=(const validation&) = default;
+
+    constexpr validation& operator=(validation&&)
+#ifndef DOXYGEN
+        noexcept(std::is_nothrow_move_assignable_v<variant<T, error_list<E, N>>>)
+#else
+        CONDITIONALLY_NOEXCEPT
+#endif
+        = default;
+
+    // NOLINTNEXTLINE(hicpp-explicit-conversions)
+    constexpr operator bool() const noexcept { return val_.index() == 0; }
+
+    [[nodiscard]] constexpr bool has_value() const noexcept { return val_.index() == 0; }
+
+    [[nodiscard]] constexpr reference operator*() & noexcept { return val_[index<0>]; }
+
+    [[nodiscard]] constexpr const_reference operator*() const& noexcept {
+        return val_[index<0>];
+    }
+
+    [[nodiscard]] constexpr rvalue_reference operator*() && {
+        return std::move(val_)[index<0>];
+    }
+
+    [[nodiscard]] constexpr const_rvalue_reference operator*() const&& {
+        return std::move(val_)[index<0>];
+    }
+
+    [[nodiscard]] constexpr pointer operator->() noexcept { return &val_[index<0>]; }
+
+    [[nodiscard]] constexpr const_pointer operator->() const noexcept {
+        return &val_[index<0>];
+    }
+
+    /// @brief Accesses the contained value
+    ///
+    /// @throws bad_result_access Thrown with a copy of all errors if the
+    /// @ref validation does not contain a value.
+    [[nodiscard]] constexpr reference value() & {
+        if (val_.index() == 0) [[likely]] {
+            return val_[index<0>];
+        }
+        detail::throw_bad_result_access(val_[index<1>]);
+    }
+
+    /// @brief Accesses the contained value
+    ///
+    /// @throws bad_result_access Thrown with a copy of all errors if the
+    /// @ref validation does not contain a value.
+    [[nodiscard]] constexpr const_reference value() const& {
+        if (val_.index() == 0) [[likely]] {
+            return val_[index<0>];
+        }
+        detail::throw_bad_result_access(val_[index<1>]);
+    }
+
+    /// @brief Accesses the contained value
+    ///
+    /// @throws bad_result_access Thrown with all errors if the @ref
+    /// validation does not contain a value.
+    [[nodiscard]] constexpr rvalue_reference value() && {
+        if (val_.index() == 0) [[likely]] {
+            return std::move(val_)[index<0>];
+        }
+        detail::throw_bad_result_access(std::move(val_)[index<1>]);
+    }
+
+    /// @brief Accesses the accumulated errors
+    ///
+    /// @details
+    /// This function is unchecked. Calling it on a @ref validation that
+    /// contains a value is undefined behavior.
+    [[nodiscard]] constexpr error_list<E, N>& errors() & noexcept { return val_[index<1>]; }
+
+    /// @brief Accesses the accumulated errors
+    ///
+    /// @details
+    /// This function is unchecked. Calling it on a @ref validation that
+    /// contains a value is undefined behavior.
+    [[nodiscard]] constexpr const error_list<E, N>& errors() const& noexcept {
+        return val_[index<1>];
+    }
+
+    /// @brief Accesses the accumulated errors
+    ///
+    /// @details
+    /// This function is unchecked. Calling it on a @ref validation that
+    /// contains a value is undefined behavior.
+    [[nodiscard]] constexpr error_list<E, N>&& errors() && {
+        return std::move(val_)[index<1>];
+    }
+
+    /// @brief Gets the number of accumulated errors, which is zero if the
+    /// @ref validation contains a value.
+    [[nodiscard]] constexpr size_t error_count() const noexcept {
+        return val_.index() == 0 ? 0 : val_[index<1>].size();
+    }
+
+    /// @brief Adds an error, constructed in place from `args`
+    ///
+    /// @details
+    /// If the @ref validation contains a value, the value is destroyed and
+    /// the new error becomes the only error.
+    template <typename... Args>
+    constexpr E& emplace_error(Args&&... args) {
+        if (val_.index() == 0) { val_.template emplace<1>(); }
+        return val_[index<1>].emplace_back(std::forward<Args>(args)...);
+    }
+
+    /// @brief Adds all errors of another @ref validation, if any
+    ///
+    /// @details
+    /// If `other` contains a value, this function does nothing. Otherwise, if
+    /// this @ref validation contains a value, the value is destroyed and the
+    /// errors of `other` become the only errors.
+    template <typename U, size_t M>
+    constexpr void merge_errors(const validation<U, E, M>& other) {
+        if (other.val_.index() != 0) {
+            if (val_.index() == 0) { val_.template emplace<1>(); }
+            val_[index<1>].append(other.val_[index<1>]);
+        }
+    }
+
+    /// @brief Moves all errors of another @ref validation, if any
+    ///
+    /// @details
+    /// If `other` contains a value, this function does nothing. Otherwise, if
+    /// this @ref validation contains a value, the value is destroyed and the
+    /// errors of `other` become the only errors.
+    template <typename U, size_t M>
+    // NOLINTNEXTLINE(cppcoreguidelines-rvalue-reference-param-not-moved)
+    constexpr void merge_errors(validation<U, E, M>&& other) {
+        if (other.val_.index() != 0) {
+            if (val_.index() == 0) { val_.template emplace<1>(); }
+            val_[index<1>].append(std::move(other.val_)[index<1>]);
+        }
+    }
+
+    template <typename F>
+    constexpr auto transform(F&& f) const& {
+        if constexpr (std::is_void_v<T>) {
+            using res_t = std::invoke_result_t<F>;
+            if (val_.index() == 0) {
+                if constexpr (std::is_void_v<res_t>) {
+                    std::invoke(std::forward<F>(f));
+                    return validation<res_t, E, N>{std::in_place};
+                } else {
+                    return validation<res_t, E, N>{std::in_place,
+                                                   std::invoke(std::forward<F>(f))};
+                }
+            } else {
+                return validation<res_t, E, N>(val_[index<1>]);
+            }
+        } else {
+            using res_t = std::invoke_result_t<F, const_reference>;
+            if (val_.index() == 0) {
+                if constexpr (std::is_void_v<res_t>) {
+                    std::invoke(std::forward<F>(f), val_[index<0>]);
+                    return validation<res_t, E, N>{std::in_place};
+                } else {
+                    return validation<res_t, E, N>{
+                        std::in_place, std::invoke(std::forward<F>(f), val_[index<0>])};
+                }
+            } else {
+                return validation<res_t, E, N>(val_[index<1>]);
+            }
+        }
+    }
+
+    template <typename F>
+    constexpr auto transform(F&& f) && {
+        if constexpr (std::is_void_v<T>) {
+            using res_t = std::invoke_result_t<F>;
+            if (val_.index() == 0) {
+                if constexpr (std::is_void_v<res_t>) {
+                    std::invoke(std::forward<F>(f));
+                    return validation<res_t, E, N>{std::in_place};
+                } else {
+                    return validation<res_t, E, N>{std::in_place,
+                                                   std::invoke(std::forward<F>(f))};
+                }
+            } else {
+                return validation<res_t, E, N>(std::move(val_)[index<1>]);
+            }
+        } else {
+            using res_t = std::invoke_result_t<F, rvalue_reference>;
+            if (val_.index() == 0) {
+                if constexpr (std::is_void_v<res_t>) {
+                    std::invoke(std::forward<F>(f), std::move(val_)[index<0>]);
+                    return validation<res_t, E, N>{std::in_place};
+                } else {
+                    return validation<res_t, E, N>{
+                        std::in_place,
+                        std::invoke(std::forward<F>(f), std::move(val_)[index<0>])};
+                }
+            } else {
+                return validation<res_t, E, N>(std::move(val_)[index<1>]);
+            }
+        }
+    }
+
+    /// @brief Converts the @ref validation into a @ref result holding all
+    /// errors.
+    [[nodiscard]] constexpr result<T, error_list<E, N>> ok_or_errors() const& {
+        if (val_.index() == 0) {
+            if constexpr (std::is_void_v<T>) {
+                return result<T, error_list<E, N>>{std::in_place};
+            } else {
+                return result<T, error_list<E, N>>{std::in_place, val_[index<0>]};
+            }
+        } else {
+            return result<T, error_list<E, N>>{in_place_error, val_[index<1>]};
+        }
+    }
+
+    /// @brief Converts the @ref validation into a @ref result holding all
+    /// errors.
+    [[nodiscard]] constexpr result<T, error_list<E, N>> ok_or_errors() && {
+        if (val_.index() == 0) {
+            if constexpr (std::is_void_v<T>) {
+                return result<T, error_list<E, N>>{std::in_place};
+            } else {
+                return result<T, error_list<E, N>>{std::in_place,
+                                                   std::move(val_)[index<0>]};
+            }
+        } else {
+            return result<T, error_list<E, N>>{in_place_error, std::move(val_)[index<1>]};
+        }
+    }
+
+    /// @brief Converts the @ref validation into a @ref result holding only
+    /// the first error.
+    [[nodiscard]] constexpr result<T, E> ok_or_first_error() const& {
+        if (val_.index() == 0) {
+            if constexpr (std::is_void_v<T>) {
+                return result<T, E>{std::in_place};
+            } else {
+                return result<T, E>{std::in_place, val_[index<0>]};
+            }
+        } else {
+            return result<T, E>{in_place_error, val_[index<1>].front()};
+        }
+    }
+
+    /// @brief Converts the @ref validation into a @ref result holding only
+    /// the first error.
+    [[nodiscard]] constexpr result<T, E> ok_or_first_error() && {
+        if (val_.index() == 0) {
+            if constexpr (std::is_void_v<T>) {
+                return result<T, E>{std::in_place};
+            } else {
+                return result<T, E>{std::in_place, std::move(val_)[index<0>]};
+            }
+        } else {
+            return result<T, E>{in_place_error, std::move(val_[index<1>].front())};
+        }
+    }
+};
+
+namespace detail {
+
+template <typename T>
+struct is_validation : std::false_type {};
+
+template <typename T, typename E, size_t N>
+struct is_validation<validation<T, E, N>> : std::true_type {};
+
+template <typename T>
+static inline constexpr bool is_validation_v = is_validation<T>::value;
+
+template <typename T>
+using validation_tuple_element_t = std::conditional_t<std::is_void_v<T>, void_t, T>;
+
+template <typename V>
+struct combined_validation;
+
+template <typename... T, typename E, size_t N>
+struct combined_validation<type_list<validation<T, E, N>...>> {
+    using type = validation<std::tuple<validation_tuple_element_t<T>...>, E, N>;
+};
+
+template <typename V>
+constexpr decltype(auto) validation_tuple_element(V&& val) {
+    if constexpr (std::is_void_v<typename std::remove_cvref_t<V>::value_type>) {
+        return void_v;
+    } else {
+        return *std::forward<V>(val);
+    }
+}
+
+} // namespace detail
+
+/// @relates validation
+/// @brief Combines independent @ref validation instances
+///
+/// @details
+/// If every @ref validation contains a value, the returned @ref validation
+/// contains a `std::tuple` of all values, where `void` values are
+/// represented as @ref void_t. Otherwise, the returned @ref validation
+/// contains the errors of every invalid argument, in argument order.
+///
+/// All arguments must have the same error type and inline capacity.
+///
+/// ## Example
+/// ```cpp
+/// validation<int, std::string> v1 = error<std::string>("bad int");
+/// validation<bool, std::string> v2 = true;
+/// validation<float, std::string> v3 = error<std::string>("bad float");
+///
+/// auto v = combine(v1, v2, v3);
+///
+/// assert(v.errors().size() == 2);
+/// assert(v.errors()[1] == "bad float");
+/// ```
+template <typename... V>
+#ifndef DOXYGEN
+    requires(sizeof...(V) > 0 &&
+             (true && ... && detail::is_validation_v<std::remove_cvref_t<V>>))
+#endif
+constexpr
+#ifndef DOXYGEN
+    typename detail::combined_validation<detail::type_list<std::remove_cvref_t<V>...>>::type
+#else
+    DEDUCED
+#endif
+    combine(V&&... vals) {
+    using ret_t = typename detail::combined_validation<
+        detail::type_list<std::remove_cvref_t<V>...>>::type;
+    if ((true && ... && vals.has_value())) [[likely]] {
+        return ret_t{std::in_place,
+                     detail::validation_tuple_element(std::forward<V>(vals))...};
+    }
+    typename ret_t::error_list_type errs;
+    (
+        [&errs](auto&& val) {
+            if (!val.has_value()) {
+                errs.append(std::forward<decltype(val)>(val).errors());
+            }
+        }(std::forward<V>(vals)),
+        ...);
+    return ret_t{std::move(errs)};
+}
+
+} // namespace sumty
+
+#endif
@@ -17,13 +17,19 @@
 #define SUMTY_VARIANT_HPP
 
 #include "sumty/detail/fwd.hpp"    // IWYU pragma: export
+#include "sumty/detail/hash.hpp"
 #include "sumty/detail/traits.hpp" // IWYU pragma: export
 #include "sumty/detail/utils.hpp"
 #include "sumty/detail/variant_impl.hpp" // IWYU pragma: export
 #include "sumty/exceptions.hpp"
 #include "sumty/utils.hpp"
 
+#include <algorithm>
+#include <array>
+#include <compare>
+#include <concepts>
 #include <cstddef>
+#include <cstdint>
 #include <functional>
 #include <initializer_list>
 #include <type_traits>
@@ -148,6 +154,64 @@ constexpr decltype(auto) visit_informed_impl(V&& visitor, U&& var) {
                                                         std::forward<U>(var));
 }
 
+template <typename U, typename T>
+static inline constexpr bool is_key_for_v =
+    !std::is_void_v<T> && requires(const std::remove_reference_t<T>& lhs, const U& rhs) {
+        { lhs == rhs } -> std::convertible_to<bool>;
+    };
+
+// Gets the index of the only alternative that can be compared for equality
+// with a U, or sizeof...(T) if there is not exactly one such alternative.
+template <typename U, typename... T>
+consteval size_t variant_key_index() noexcept {
+    constexpr std::array<bool, sizeof...(T)> matches{is_key_for_v<U, T>...};
+    size_t found = sizeof...(T);
+    for (size_t i = 0; i < sizeof...(T); ++i) {
+        if (matches[i]) {
+            if (found != sizeof...(T)) { return sizeof...(T); }
+            found = i;
+        }
+    }
+    return found;
+}
+
+// Alternatives whose equality is equality of their bytes. This is limited to
+// scalars, since class types with unique object representations may still
+// define operator== differently.
+template <typename T>
+static inline constexpr bool is_bytewise_comparable_v =
+    std::is_scalar_v<T> && std::has_unique_object_representations_v<T>;
+
+template <typename T, typename U>
+struct variant_cmp_result {};
+
+template <typename T, typename U>
+    requires(!std::is_void_v<T> && !std::is_void_v<U>)
+struct variant_cmp_result<T, U>
+    : std::compare_three_way_result<const std::remove_reference_t<T>&,
+                                    const std::remove_reference_t<U>&> {};
+
+template <>
+struct variant_cmp_result<void, void> {
+    using type = std::strong_ordering;
+};
+
+template <typename... T>
+static inline constexpr std::array<size_t, sizeof...(T)> alternative_sizes{sizeof(T)...};
+
+// Loads N <= 8 bytes into a word. The shifts are unrolled so that compilers
+// merge them into a single load.
+template <size_t N>
+uint64_t load_word(const unsigned char* bytes) noexcept {
+    return [bytes]<size_t... I>([[maybe_unused]] std::index_sequence<I...> seq) {
+        return ((uint64_t{bytes[I]} << (I * 8U)) | ... | uint64_t{0});
+    }(std::make_index_sequence<N>{});
+}
+
+template <typename T, typename U>
+static inline constexpr bool is_variant_three_way_comparable_v =
+    requires { typename variant_cmp_result<T, U>::type; };
+
 } // namespace detail
 
 /// @class variant variant.hpp <sumty/variant.hpp>
@@ -1333,8 +1397,10 @@ class variant {
         REFERENCE
 #endif
         get() & {
-        if (index() != I) { throw bad_variant_access(); }
-        return data_.template get<I>();
+        if (index() == I) [[likely]] {
+            return data_.template get<I>();
+        }
+        detail::throw_bad_variant_access();
     }
 
     /// @brief Gets an alternative by index
@@ -1368,8 +1434,10 @@ class variant {
         CONST_REFERENCE
 #endif
         get() const& {
-        if (index() != I) { throw bad_variant_access(); }
-        return data_.template get<I>();
+        if (index() == I) [[likely]] {
+            return data_.template get<I>();
+        }
+        detail::throw_bad_variant_access();
     }
 
     /// @brief Gets an alternative by index
@@ -1403,8 +1471,10 @@ class variant {
         RVALUE_REFERENCE
 #endif
         get() && {
-        if (index() != I) { throw bad_variant_access(); }
-        return std::move(data_).template get<I>();
+        if (index() == I) [[likely]] {
+            return std::move(data_).template get<I>();
+        }
+        detail::throw_bad_variant_access();
     }
 
     /// @brief Gets an alternative by index
@@ -1438,8 +1508,10 @@ class variant {
         CONST_RVALUE_REFERENCE
 #endif
         get() const&& {
-        if (index() != I) { throw bad_variant_access(); }
-        return std::move(data_).template get<I>();
+        if (index() == I) [[likely]] {
+            return std::move(data_).template get<I>();
+        }
+        detail::throw_bad_variant_access();
     }
 
     /// @brief Gets an alternative by type
@@ -3005,6 +3077,143 @@ constexpr void swap(variant<T...>& a, variant<T...>& b)
     a.swap(b);
 }
 
+/// @relates variant
+/// @brief Tests two @ref variant instances for equality
+///
+/// @details
+/// Two @ref variant instances are equal if they hold the alternative with
+/// the same index, and those alternatives are equal. The indices are
+/// compared first, and the alternatives are only compared, with a single
+/// dispatch on the index, if the indices match. `void` alternatives with the
+/// same index are always equal.
+///
+/// If every alternative is a scalar type with unique object
+/// representations, such as an integer, enum, or pointer, no dispatch is
+/// needed at all: the alternatives are compared bytewise. When all
+/// alternatives have the same size of at most 8 bytes, this is a single word
+/// compare alongside the index compare, with no branch, and otherwise a
+/// single `memcmp` of the size of the held alternative.
+///
+/// ## Example
+/// ```cpp
+/// variant<int, std::string> v1{std::in_place_index<0>, 42};
+/// variant<int, std::string> v2{std::in_place_index<1>, "hello"};
+///
+/// assert(v1 == v1);
+/// assert(v1 != v2);
+/// ```
+template <typename... T, typename... U>
+#ifndef DOXYGEN
+    requires(sizeof...(T) == sizeof...(U))
+#endif
+constexpr bool operator==(const variant<T...>& lhs, const variant<U...>& rhs) {
+    if constexpr ((std::is_same_v<T, U> && ...) &&
+                  (detail::is_bytewise_comparable_v<T> && ...)) {
+        if (!std::is_constant_evaluated()) {
+            // All alternatives share the address of the storage, so the held
+            // alternative is compared without dispatching on its type.
+            constexpr const auto& sizes = detail::alternative_sizes<T...>;
+            constexpr bool same_size = ((sizeof(T) == sizes[0]) && ...);
+            const auto* lhs_bytes = reinterpret_cast<const unsigned char*>(
+                std::addressof(lhs[sumty::index<0>]));
+            const auto* rhs_bytes = reinterpret_cast<const unsigned char*>(
+                std::addressof(rhs[sumty::index<0>]));
+            if constexpr (same_size && sizes[0] <= sizeof(uint64_t)) {
+                // small alternatives are loaded into a single word each, so
+                // the comparison has no branch on the held alternative
+                return (lhs.index() == rhs.index()) &
+                       (detail::load_word<sizes[0]>(lhs_bytes) ==
+                        detail::load_word<sizes[0]>(rhs_bytes));
+            } else {
+                return lhs.index() == rhs.index() &&
+                       std::equal(lhs_bytes, lhs_bytes + sizes[lhs.index()], rhs_bytes);
+            }
+        }
+    }
+    if (lhs.index() != rhs.index()) { return false; }
+    return lhs.visit_informed([&rhs](const auto& value, auto info) -> bool {
+        constexpr size_t IDX = decltype(info)::index;
+        if constexpr (std::is_void_v<detail::select_t<IDX, T...>>) {
+            return std::is_void_v<detail::select_t<IDX, U...>>;
+        } else {
+            return value == rhs[sumty::index<IDX>];
+        }
+    });
+}
+
+/// @relates variant
+/// @brief Compares two @ref variant instances
+///
+/// @details
+/// As with `std::variant`, a @ref variant that holds an alternative with a
+/// lower index is less than one that holds an alternative with a higher
+/// index. If both hold the alternative with the same index, the result is
+/// the comparison of those alternatives, which takes a single dispatch on
+/// the index. `void` alternatives with the same index are equal.
+///
+/// ## Example
+/// ```cpp
+/// variant<int, std::string> v1{std::in_place_index<0>, 42};
+/// variant<int, std::string> v2{std::in_place_index<0>, 24};
+/// variant<int, std::string> v3{std::in_place_index<1>, "hello"};
+///
+/// assert((v1 <=> v2) == std::strong_ordering::greater);
+/// assert((v1 <=> v3) == std::strong_ordering::less);
+/// ```
+template <typename... T, typename... U>
+#ifndef DOXYGEN
+    requires(sizeof...(T) == sizeof...(U) &&
+             (detail::is_variant_three_way_comparable_v<T, U> && ...))
+#endif
+constexpr
+#ifndef DOXYGEN
+    std::common_comparison_category_t<typename detail::variant_cmp_result<T, U>::type...>
+#else
+    auto
+#endif
+    operator<=>(const variant<T...>& lhs, const variant<U...>& rhs) {
+    using ret_t = std::common_comparison_category_t<
+        typename detail::variant_cmp_result<T, U>::type...>;
+    if (lhs.index() != rhs.index()) { return lhs.index() <=> rhs.index(); }
+    return lhs.visit_informed([&rhs](const auto& value, auto info) -> ret_t {
+        constexpr size_t IDX = decltype(info)::index;
+        if constexpr (std::is_void_v<detail::select_t<IDX, T...>>) {
+            return std::strong_ordering::equal;
+        } else {
+            return value <=> rhs[sumty::index<IDX>];
+        }
+    });
+}
+
+/// @relates variant
+/// @brief Compares a @ref variant with a value
+///
+/// @details
+/// The @ref variant is equal to the value if the alternative it holds can
+/// be compared with the value, and compares equal to it. At least one
+/// alternative must be comparable with the value.
+///
+/// ## Example
+/// ```cpp
+/// variant<int, std::string> v{std::in_place_index<1>, "hello"};
+///
+/// assert(v == std::string_view{"hello"});
+/// assert(v != 42);
+/// ```
+template <typename... T, typename U>
+#ifndef DOXYGEN
+    requires(!detail::is_variant_v<U> && (detail::is_key_for_v<U, T> || ...))
+#endif
+constexpr bool operator==(const variant<T...>& lhs, const U& rhs) {
+    return lhs.visit([&rhs](const auto& value) -> bool {
+        if constexpr (requires { value == rhs; }) {
+            return value == rhs;
+        } else {
+            return false;
+        }
+    });
+}
+
 /// @relates variant
 /// @class variant_size variant.hpp <sumty/variant.hpp>
 /// @brief Utility to get the number of alternative in a @ref variant
@@ -3094,4 +3303,69 @@ using variant_alternative_t = typename variant_alternative<I, T>::type;
 
 } // namespace sumty
 
+namespace std {
+
+/// @relates sumty::variant
+/// @brief `std::hash` specialization for @ref sumty::variant
+///
+/// @details
+/// The hash combines the index of the held alternative with the hash of the
+/// alternative, so equal values of different alternatives hash differently.
+/// Alternatives are hashed with `std::hash` if it is enabled for them, or
+/// else bytewise if they have unique object representations. `void`
+/// alternatives only contribute their index, and references are hashed by
+/// the value they refer to.
+///
+/// The hasher is transparent, so a container that also uses a transparent
+/// equality comparison, such as `std::equal_to<>`, can be searched without
+/// constructing a @ref sumty::variant, with a key that can be compared with
+/// exactly one of the alternatives and is guaranteed to hash the same as the
+/// equal value of that alternative. That is, the key must either have the
+/// same type as the alternative, or be convertible to a
+/// `std::basic_string_view` when the alternative is a `std::basic_string`.
+/// Other keys, such as a `double` key for an `int` alternative, are not
+/// hashed directly, since equal values of different types may hash
+/// differently.
+///
+/// ## Example
+/// ```cpp
+/// using key = variant<int, std::string>;
+/// std::unordered_map<key, int, std::hash<key>, std::equal_to<>> map{};
+///
+/// map.emplace(key{std::in_place_index<1>, "answer"}, 42);
+///
+/// assert(map.find(std::string_view{"answer"})->second == 42);
+/// ```
+template <typename... T>
+#ifndef DOXYGEN
+    requires(sumty::detail::is_hashable_v<T> && ...)
+#endif
+struct hash<sumty::variant<T...>> {
+    using is_transparent = void;
+
+    size_t operator()(const sumty::variant<T...>& var) const {
+        return var.visit_informed([](const auto& value, auto info) {
+            return sumty::detail::hash_mix(decltype(info)::index,
+                                           sumty::detail::hash_value(value));
+        });
+    }
+
+    template <typename U>
+#ifndef DOXYGEN
+        requires(!sumty::detail::is_variant_v<U> &&
+                 sumty::detail::variant_key_index<U, T...>() < sizeof...(T) &&
+                 sumty::detail::is_hash_key_for_v<
+                     U,
+                     std::remove_cvref_t<sumty::detail::select_t<
+                         sumty::detail::variant_key_index<U, T...>(), T...>>>)
+#endif
+    size_t operator()(const U& key) const {
+        static constexpr size_t idx = sumty::detail::variant_key_index<U, T...>();
+        using alt_t = std::remove_cvref_t<sumty::detail::select_t<idx, T...>>;
+        return sumty::detail::hash_mix(idx, sumty::detail::hash_key<alt_t>(key));
+    }
+};
+
+} // namespace std
+
 #endif
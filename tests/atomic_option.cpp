@@ -0,0 +1,109 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "sumty/atomic_option.hpp" // IWYU pragma: associated
+#include "sumty/option.hpp"
+
+using namespace sumty;
+
+namespace {
+
+struct config {
+    int threads;
+    int timeout_ms;
+};
+
+struct big_config {
+    std::array<uint64_t, 4> values;
+};
+
+} // namespace
+
+TEST_CASE("atomic_option lock free", "[atomic_option]") {
+    STATIC_CHECK(atomic_option<int>::is_always_lock_free);
+    STATIC_CHECK(atomic_option<int&>::is_always_lock_free);
+    STATIC_CHECK(atomic_option<uint32_t>::is_always_lock_free);
+    STATIC_CHECK(!atomic_option<big_config>::is_always_lock_free);
+}
+
+TEST_CASE("atomic_option operations", "[atomic_option]") {
+    atomic_option<int> opt{};
+    REQUIRE(!opt.load().has_value());
+    opt.store(42);
+    REQUIRE(opt.load() == 42);
+    REQUIRE(opt.exchange(24) == 42);
+    option<int> expected = 42;
+    REQUIRE(!opt.compare_exchange(expected, 7));
+    REQUIRE(expected == 24);
+    REQUIRE(opt.compare_exchange(expected, 7));
+    REQUIRE(opt.load() == 7);
+    REQUIRE(opt.take() == 7);
+    REQUIRE(opt.load() == none);
+    option<int> empty{};
+    REQUIRE(opt.compare_exchange(empty, 1));
+    REQUIRE(opt.load() == 1);
+}
+
+TEST_CASE("atomic_option reference", "[atomic_option]") {
+    int value1 = 1;
+    int value2 = 2;
+    atomic_option<int&> opt{};
+    REQUIRE(opt.load() == none);
+    opt.store(option<int&>{&value1});
+    REQUIRE(&*opt.load() == &value1);
+    option<int&> expected{&value1};
+    REQUIRE(opt.compare_exchange(expected, option<int&>{&value2}));
+    REQUIRE(&*opt.take() == &value2);
+    REQUIRE(!opt.load().has_value());
+}
+
+TEST_CASE("atomic_option seqlock fallback", "[atomic_option]") {
+    atomic_option<big_config> opt{};
+    REQUIRE(!opt.load().has_value());
+    opt.store(big_config{{1, 2, 3, 4}});
+    REQUIRE(opt.load()->values[3] == 4);
+    option<big_config> expected = big_config{{1, 2, 3, 4}};
+    REQUIRE(opt.compare_exchange(expected, big_config{{5, 6, 7, 8}}));
+    REQUIRE(opt.take()->values[0] == 5);
+    REQUIRE(opt.load() == none);
+}
+
+TEST_CASE("atomic_option wait", "[atomic_option]") {
+    atomic_option<config> opt{};
+    std::thread writer([&opt] {
+        opt.store(config{4, 100});
+        opt.notify_all();
+    });
+    opt.wait(none);
+    writer.join();
+    REQUIRE(opt.load().value().threads == 4);
+}
+
+TEST_CASE("atomic_option concurrent snapshots", "[atomic_option]") {
+    static constexpr uint64_t ITERATIONS = 10000;
+    atomic_option<big_config> opt{big_config{{0, 0, 0, 0}}};
+    std::atomic<bool> torn{false};
+    std::thread writer([&opt] {
+        for (uint64_t i = 1; i <= ITERATIONS; ++i) { opt.store(big_config{{i, i, i, i}}); }
+    });
+    std::vector<std::thread> readers;
+    for (int r = 0; r < 2; ++r) {
+        readers.emplace_back([&opt, &torn] {
+            for (uint64_t i = 0; i < ITERATIONS; ++i) {
+                const auto vals = opt.load().value_or(big_config{}).values;
+                if (vals[0] != vals[1] || vals[1] != vals[2] || vals[2] != vals[3]) {
+                    torn = true;
+                }
+            }
+        });
+    }
+    writer.join();
+    for (auto& reader : readers) { reader.join(); }
+    REQUIRE(!torn);
+    REQUIRE(opt.load()->values[0] == ITERATIONS);
+}
@@ -0,0 +1,116 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "sumty/atomic_variant.hpp" // IWYU pragma: associated
+#include "sumty/utils.hpp"
+#include "sumty/variant.hpp"
+
+using namespace sumty;
+
+namespace {
+
+struct idle {};
+
+struct connecting {
+    uint32_t attempt;
+};
+
+struct connected {
+    int fd;
+};
+
+struct closed {};
+
+} // namespace
+
+TEST_CASE("atomic_variant lock free", "[atomic_variant]") {
+    STATIC_CHECK(atomic_variant<int, float, void>::is_always_lock_free);
+    STATIC_CHECK(atomic_variant<idle, connecting, closed>::is_always_lock_free);
+    STATIC_CHECK(!atomic_variant<int, uint64_t[4]>::is_always_lock_free);
+}
+
+TEST_CASE("atomic_variant operations", "[atomic_variant]") {
+    using state_t = variant<idle, connecting, closed>;
+    atomic_variant<idle, connecting, closed> state{};
+    REQUIRE(state.index() == 0);
+    state.store(connecting{1});
+    REQUIRE(state.index() == 1);
+    REQUIRE(get<1>(state.load()).attempt == 1);
+    auto prev = state.exchange(connecting{2});
+    REQUIRE(get<1>(prev).attempt == 1);
+
+    state_t expected{connecting{1}};
+    REQUIRE(!state.compare_exchange(expected, closed{}));
+    REQUIRE(get<1>(expected).attempt == 2);
+    REQUIRE(state.compare_exchange(expected, closed{}));
+    REQUIRE(state.index() == 2);
+
+    expected = idle{};
+    REQUIRE(!state.compare_exchange(expected, connecting{3}));
+    REQUIRE(expected.index() == 2);
+}
+
+TEST_CASE("atomic_variant reference alternative", "[atomic_variant]") {
+    connected conn{42};
+    atomic_variant<idle, connected&, closed> state{};
+    state.store(variant<idle, connected&, closed>(std::in_place_index<1>, conn));
+    REQUIRE(&get<1>(state.load()) == &conn);
+    auto fd = state.visit(overload([](idle) { return -1; },
+                                   [](connected& c) { return c.fd; },
+                                   [](closed) { return -2; }));
+    REQUIRE(fd == 42);
+}
+
+TEST_CASE("atomic_variant in place", "[atomic_variant]") {
+    atomic_variant<int, void, float> var{std::in_place_index<2>, 1.5F};
+    REQUIRE(var.index() == 2);
+    REQUIRE(get<2>(var.load()) == 1.5F);
+    var.store(variant<int, void, float>(std::in_place_index<1>));
+    REQUIRE(var.index() == 1);
+}
+
+TEST_CASE("atomic_variant seqlock fallback", "[atomic_variant]") {
+    using big_t = std::array<uint64_t, 4>;
+    atomic_variant<int, big_t> var{};
+    REQUIRE(get<0>(var.load()) == 0);
+    var.store(big_t{1, 2, 3, 4});
+    REQUIRE(get<1>(var.load())[3] == 4);
+    variant<int, big_t> expected{big_t{1, 2, 3, 4}};
+    REQUIRE(var.compare_exchange(expected, 5));
+    REQUIRE(get<0>(var.load()) == 5);
+}
+
+TEST_CASE("atomic_variant contended transitions", "[atomic_variant]") {
+    static constexpr uint32_t THREADS = 4;
+    static constexpr uint32_t ITERATIONS = 1000;
+    atomic_variant<idle, connecting, closed> state{};
+    std::vector<std::thread> threads;
+    for (uint32_t t = 0; t < THREADS; ++t) {
+        threads.emplace_back([&state] {
+            for (uint32_t i = 0; i < ITERATIONS; ++i) {
+                auto cur = state.load();
+                for (;;) {
+                    const uint32_t attempt = cur.index() == 1 ? get<1>(cur).attempt + 1 : 1;
+                    if (state.compare_exchange(cur, connecting{attempt})) { break; }
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) { thread.join(); }
+    REQUIRE(get<1>(state.load()).attempt == THREADS * ITERATIONS);
+}
+
+TEST_CASE("atomic_variant wait", "[atomic_variant]") {
+    atomic_variant<idle, connecting, closed> state{};
+    std::thread closer([&state] {
+        state.store(closed{});
+        state.notify_all();
+    });
+    state.wait(idle{});
+    closer.join();
+    REQUIRE(state.index() == 2);
+}
@@ -0,0 +1,85 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdint>
+#include <future>
+#include <string>
+#include <system_error>
+#include <type_traits>
+
+#include "sumty/compact_error.hpp" // IWYU pragma: associated
+#include "sumty/result.hpp"
+
+using namespace sumty;
+
+namespace {
+
+class custom_category_t : public std::error_category {
+  public:
+    [[nodiscard]] const char* name() const noexcept override { return "custom"; }
+
+    [[nodiscard]] std::string message(int value) const override {
+        return "custom error " + std::to_string(value);
+    }
+};
+
+const custom_category_t custom_category{};
+
+result_c<int> parse_digit(char c) {
+    if (c < '0' || c > '9') { return error<compact_error>(std::errc::invalid_argument); }
+    return c - '0';
+}
+
+} // namespace
+
+TEST_CASE("compact_error size", "[compact_error]") {
+    STATIC_CHECK(sizeof(compact_error) == sizeof(uint32_t));
+    STATIC_CHECK(sizeof(result_c<int>) == 8);
+    STATIC_CHECK(std::is_trivially_copyable_v<compact_error>);
+    STATIC_CHECK(std::is_trivially_copyable_v<result_c<int>>);
+}
+
+TEST_CASE("compact_error default construct", "[compact_error]") {
+    compact_error err{};
+    REQUIRE(!err);
+    REQUIRE(err.value() == 0);
+    REQUIRE(err.category() == std::system_category());
+    REQUIRE(std::error_code(err) == std::error_code{});
+}
+
+TEST_CASE("compact_error round trip", "[compact_error]") {
+    compact_error err1 = std::make_error_code(std::errc::invalid_argument);
+    REQUIRE(err1);
+    REQUIRE(err1.to_error_code() == std::errc::invalid_argument);
+    REQUIRE(err1.category() == std::generic_category());
+
+    compact_error err2 = std::future_errc::no_state;
+    REQUIRE(std::error_code(err2) == std::future_errc::no_state);
+
+    compact_error err3{-42, custom_category};
+    REQUIRE(err3.value() == -42);
+    REQUIRE(err3.category() == custom_category);
+    REQUIRE(err3.message() == "custom error -42");
+    REQUIRE(compact_error(-42, custom_category) == err3);
+    REQUIRE(compact_error::from_bits(err3.bits()) == err3);
+
+    compact_error err4{compact_error::min_value, custom_category};
+    REQUIRE(err4.value() == compact_error::min_value);
+    compact_error err5{compact_error::max_value, custom_category};
+    REQUIRE(err5.value() == compact_error::max_value);
+}
+
+TEST_CASE("compact_error out of range", "[compact_error]") {
+    const std::error_code ec{compact_error::max_value + 1, custom_category};
+    REQUIRE(!compact_error::try_from(ec).has_value());
+    compact_error err = ec;
+    REQUIRE(err.to_error_code() == std::errc::value_too_large);
+}
+
+TEST_CASE("compact_error result", "[compact_error]") {
+    auto res1 = parse_digit('7');
+    REQUIRE(res1.has_value());
+    REQUIRE(*res1 == 7);
+    auto res2 = parse_digit('x');
+    REQUIRE(!res2.has_value());
+    REQUIRE(res2.error().to_error_code() == std::errc::invalid_argument);
+}
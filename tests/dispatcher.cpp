@@ -0,0 +1,87 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "sumty/dispatcher.hpp" // IWYU pragma: associated
+#include "sumty/utils.hpp"
+#include "sumty/variant.hpp"
+
+using namespace sumty;
+
+namespace {
+
+struct order {
+    int id;
+};
+
+struct cancel {
+    int id;
+};
+
+using message = variant<order, cancel, std::string>;
+
+} // namespace
+
+TEST_CASE("dispatcher grouped", "[dispatcher]") {
+    std::vector<std::string> log;
+    auto router = make_dispatcher<message>(overload(
+        [&log](std::span<order> orders) {
+            log.push_back(std::string("orders:").append(std::to_string(orders.size())));
+            for (auto& o : orders) {
+                log.push_back(std::string("o").append(std::to_string(o.id)));
+            }
+        },
+        [&log](cancel&& c) {
+            log.push_back(std::string("c").append(std::to_string(c.id)));
+        },
+        [&log](std::span<std::string> strs) {
+            for (auto& str : strs) { log.push_back(std::move(str)); }
+        }));
+
+    std::vector<message> mailbox{order{1}, cancel{2}, std::string("s"), order{3},
+                                 cancel{4}};
+    router.dispatch(mailbox);
+    REQUIRE(log == std::vector<std::string>{"orders:2", "o1", "o3", "c2", "c4", "s"});
+
+    log.clear();
+    router.dispatch(std::span<message>{});
+    REQUIRE(log.empty());
+}
+
+TEST_CASE("dispatcher in order", "[dispatcher]") {
+    std::vector<std::string> log;
+    auto router = make_dispatcher<message>(overload(
+        [&log](std::span<order> orders) {
+            log.push_back(std::string("orders:").append(std::to_string(orders.size())));
+        },
+        [&log](std::span<cancel> cancels) {
+            log.push_back(std::string("cancels:").append(std::to_string(cancels.size())));
+        },
+        [&log](std::string&& str) { log.push_back(std::move(str)); }));
+
+    std::vector<message> mailbox{order{1}, order{2}, cancel{3}, order{4},
+                                 std::string("a"), std::string("b")};
+    router.dispatch_in_order(mailbox);
+    REQUIRE(log ==
+            std::vector<std::string>{"orders:2", "cancels:1", "orders:1", "a", "b"});
+}
+
+TEST_CASE("dispatcher handler exception", "[dispatcher]") {
+    int orders_seen = 0;
+    auto router = make_dispatcher<variant<order, cancel>>(overload(
+        [&orders_seen](std::span<order> orders) {
+            orders_seen += static_cast<int>(orders.size());
+        },
+        [](cancel&&) { throw std::runtime_error("oops"); }));
+
+    std::vector<variant<order, cancel>> mailbox{order{1}, cancel{2}, cancel{3}};
+    REQUIRE_THROWS_AS(router.dispatch(mailbox), std::runtime_error);
+    REQUIRE(orders_seen == 1);
+
+    std::vector<variant<order, cancel>> next{order{4}};
+    router.dispatch(next);
+    REQUIRE(orders_seen == 2);
+}
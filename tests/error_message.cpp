@@ -0,0 +1,119 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "sumty/error_message.hpp" // IWYU pragma: associated
+#include "sumty/error_set.hpp"
+#include "sumty/result.hpp"
+
+using namespace sumty;
+
+namespace {
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+std::atomic<size_t> allocations{0};
+
+result<int, error_message> parse(std::string_view str) {
+    if (str.empty()) {
+        return error<error_message>(error_message::from_static("empty input"));
+    }
+    if (str.size() > 3) { return error<error_message>("input too long"); }
+    return static_cast<int>(str.size());
+}
+
+} // namespace
+
+// NOLINTBEGIN(cppcoreguidelines-no-malloc,hicpp-no-malloc)
+void* operator new(size_t size) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* ptr = std::malloc(size == 0 ? 1 : size)) { return ptr; }
+    throw std::bad_alloc{};
+}
+
+void* operator new[](size_t size) { return ::operator new(size); }
+
+void* operator new(size_t size, [[maybe_unused]] const std::nothrow_t& tag) noexcept {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    return std::malloc(size == 0 ? 1 : size);
+}
+
+void* operator new[](size_t size, const std::nothrow_t& tag) noexcept {
+    return ::operator new(size, tag);
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+
+void operator delete(void* ptr, [[maybe_unused]] size_t size) noexcept { std::free(ptr); }
+
+void operator delete[](void* ptr) noexcept { std::free(ptr); }
+
+void operator delete[](void* ptr, [[maybe_unused]] size_t size) noexcept { std::free(ptr); }
+// NOLINTEND(cppcoreguidelines-no-malloc,hicpp-no-malloc)
+
+TEST_CASE("error_message inline", "[error_message]") {
+    const auto before = allocations.load();
+    error_message msg1 = "short message";
+    error_message msg2 = msg1;
+    error_message msg3 = std::move(msg1);
+    error_message msg4{std::string_view("exactly forty seven characters long, inline ok!")};
+    const auto after = allocations.load();
+    REQUIRE(after == before);
+    REQUIRE(msg2 == "short message");
+    REQUIRE(msg3 == msg2);
+    REQUIRE(msg3.is_inline());
+    REQUIRE(msg4.size() == error_message::inline_capacity);
+    REQUIRE(msg4.is_inline());
+}
+
+TEST_CASE("error_message static", "[error_message]") {
+    const auto before = allocations.load();
+    auto msg1 = error_message::from_static(
+        "a string literal that is far too long to be stored inline in the message");
+    error_message msg2 = msg1;
+    error_message msg3 = std::move(msg2);
+    const auto after = allocations.load();
+    REQUIRE(after == before);
+    REQUIRE(msg1.is_static());
+    REQUIRE(msg3.is_static());
+    REQUIRE(msg3.c_str() == msg1.c_str());
+}
+
+TEST_CASE("error_message heap", "[error_message]") {
+    const std::string long_str(100, 'x');
+    error_message msg1 = long_str;
+    REQUIRE(!msg1.is_inline());
+    REQUIRE(!msg1.is_static());
+    REQUIRE(msg1.view() == long_str);
+    const auto before = allocations.load();
+    error_message msg2 = std::move(msg1);
+    const auto after = allocations.load();
+    REQUIRE(after == before);
+    REQUIRE(msg2 == long_str);
+    REQUIRE(msg1.empty()); // NOLINT(bugprone-use-after-move,hicpp-invalid-access-moved)
+    error_message msg3 = msg2;
+    REQUIRE(msg3 == msg2);
+    REQUIRE(msg3.c_str() != msg2.c_str());
+}
+
+TEST_CASE("error_message result", "[error_message]") {
+    const auto before = allocations.load();
+    auto res1 = parse("");
+    auto res2 = parse("abcd");
+    auto res3 = parse("ab");
+    const auto after = allocations.load();
+    REQUIRE(after == before);
+    REQUIRE(res1.error() == "empty input");
+    REQUIRE(res1.error().is_static());
+    REQUIRE(res2.error() == "input too long");
+    REQUIRE(*res3 == 2);
+
+    error_set<int, error_message> err = error_message("bad");
+    REQUIRE(holds_alternative<error_message>(err));
+    REQUIRE(get<error_message>(err) == "bad");
+}
@@ -1,5 +1,10 @@
 #include <catch2/catch_test_macros.hpp>
 
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <string_view>
+
 #include "sumty/error_set.hpp" // IWYU pragma: associated
 #include "sumty/result.hpp"
 
@@ -12,6 +17,18 @@ struct myerr {
 
 struct empty_t {};
 
+template <>
+struct sumty::error_descriptor<myerr<1>> {
+    static constexpr std::string_view name = "myerr<1>";
+    static constexpr int code = 101;
+    static constexpr error_severity severity = error_severity::warning;
+};
+
+template <>
+struct sumty::error_descriptor<myerr<2>> {
+    static constexpr std::string_view name = "myerr<2>";
+};
+
 template <typename T>
 constexpr T max(T value) {
     return value;
@@ -123,3 +140,45 @@ TEST_CASE("error_set propagate by result", "[error_set]") {
     REQUIRE(res.error().index() == 1);
     REQUIRE(get<1>(res.error()).value == 42);
 }
+
+TEST_CASE("error_set index of", "[error_set]") {
+    using errors = error_set<myerr<0>, myerr<1>, myerr<2>>;
+    STATIC_CHECK(error_set_index_v<myerr<0>, errors> == 0);
+    STATIC_CHECK(error_set_index_v<myerr<2>, errors> == 2);
+    STATIC_CHECK(error_set_index_v<myerr<1>, const errors> == 1);
+
+    std::array<size_t, error_set_size_v<errors>> counts{};
+    const errors err{std::in_place_index<1>, 42};
+    ++counts[err.index()];
+    REQUIRE(counts[error_set_index_v<myerr<1>, errors>] == 1);
+}
+
+TEST_CASE("error_set describe", "[error_set]") {
+    using errors = error_set<myerr<0>, myerr<1>, myerr<2>>;
+    const errors err0{std::in_place_index<0>};
+    const errors err1{std::in_place_index<1>, 42};
+    const errors err2{std::in_place_index<2>};
+
+    const auto desc0 = describe(err0);
+    REQUIRE(desc0.name.empty());
+    REQUIRE(desc0.code == 0);
+    REQUIRE(desc0.severity == error_severity::error);
+
+    const auto desc1 = describe(err1);
+    REQUIRE(desc1.name == "myerr<1>");
+    REQUIRE(desc1.code == 101);
+    REQUIRE(desc1.severity == error_severity::warning);
+
+    const auto desc2 = describe(err2);
+    REQUIRE(desc2.name == "myerr<2>");
+    REQUIRE(desc2.code == 0);
+}
+
+TEST_CASE("error_set hash", "[error_set]") {
+    using set_t = error_set<myerr<1>, myerr<2>>;
+    const std::hash<set_t> hasher{};
+    const set_t err1 = myerr<1>{7};
+    const set_t err2 = myerr<2>{7};
+    REQUIRE(hasher(err1) == hasher(set_t{myerr<1>{7}}));
+    REQUIRE(hasher(err1) != hasher(err2));
+}
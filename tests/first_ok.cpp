@@ -0,0 +1,149 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include <stop_token>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "sumty/first_ok.hpp" // IWYU pragma: associated
+#include "sumty/result.hpp"
+
+using namespace sumty;
+using namespace std::chrono_literals;
+
+namespace {
+
+class thread_executor {
+  private:
+    std::mutex mtx_{};
+    std::vector<std::thread> threads_{};
+
+  public:
+    thread_executor() = default;
+    thread_executor(const thread_executor&) = delete;
+    thread_executor(thread_executor&&) = delete;
+    thread_executor& operator=(const thread_executor&) = delete;
+    thread_executor& operator=(thread_executor&&) = delete;
+
+    ~thread_executor() {
+        for (auto& thread : threads_) { thread.join(); }
+    }
+
+    void execute(std::function<void()> task) {
+        const std::lock_guard lock{mtx_};
+        threads_.emplace_back(std::move(task));
+    }
+};
+
+} // namespace
+
+TEST_CASE("first_ok returns the first success", "[first_ok]") {
+    thread_executor pool{};
+    auto res = first_ok(
+        pool,
+        []() -> result<int, std::string> {
+            std::this_thread::sleep_for(1ms);
+            return error<std::string>("miss");
+        },
+        [](std::stop_token) -> result<int, int> { return 42; });
+    REQUIRE(res.has_value());
+    REQUIRE(*res == 42);
+}
+
+TEST_CASE("first_ok cancels losers", "[first_ok]") {
+    std::atomic<bool> started{false};
+    std::atomic<bool> stopped{false};
+    {
+        thread_executor pool{};
+        auto res = first_ok(
+            pool,
+            [&started, &stopped](const std::stop_token& stop) -> result<int, int> {
+                started = true;
+                while (!stop.stop_requested()) { std::this_thread::yield(); }
+                stopped = true;
+                return error<int>(-1);
+            },
+            [&started]() -> result<int, int> {
+                while (!started) { std::this_thread::yield(); }
+                return 1;
+            });
+        REQUIRE(res == 1);
+    }
+    REQUIRE(stopped);
+}
+
+TEST_CASE("first_ok all fail", "[first_ok]") {
+    thread_executor pool{};
+    auto res = first_ok(
+        pool, []() -> result<int, std::string> { return error<std::string>("a"); },
+        []() -> result<int, int> { return error<int>(2); });
+    REQUIRE(!res.has_value());
+    REQUIRE(std::get<0>(res.error()) == "a");
+    REQUIRE(std::get<1>(res.error()) == 2);
+}
+
+TEST_CASE("first_ok with callable executor", "[first_ok]") {
+    std::vector<std::function<void()>> queue{};
+    std::thread runner{};
+    auto exec = [&queue](std::function<void()> task) { queue.push_back(std::move(task)); };
+    auto res = first_ok(
+        [&](std::function<void()> task) {
+            exec(std::move(task));
+            if (queue.size() == 2) {
+                runner = std::thread([tasks = std::move(queue)] {
+                    for (const auto& run : tasks) { run(); }
+                });
+            }
+        },
+        []() -> result<void, int> { return error<int>(1); }, []() -> result<void, int> {
+            return {};
+        });
+    runner.join();
+    REQUIRE(res.has_value());
+}
+
+TEST_CASE("first_ok sequential", "[first_ok]") {
+    int calls = 0;
+    auto res = first_ok(
+        1s,
+        [&calls]() -> result<int, int> {
+            ++calls;
+            return error<int>(1);
+        },
+        [&calls](const std::stop_token& stop) -> result<int, int> {
+            ++calls;
+            REQUIRE(!stop.stop_possible());
+            return 2;
+        },
+        [&calls]() -> result<int, int> {
+            ++calls;
+            return 3;
+        });
+    REQUIRE(res == 2);
+    REQUIRE(calls == 2);
+}
+
+TEST_CASE("first_ok sequential timeout", "[first_ok]") {
+    int calls = 0;
+    auto res = first_ok(
+        1ms,
+        [&calls]() -> result<int, int> {
+            ++calls;
+            std::this_thread::sleep_for(5ms);
+            return error<int>(1);
+        },
+        [&calls]() -> result<int, std::string> {
+            ++calls;
+            return 2;
+        });
+    REQUIRE(calls == 1);
+    REQUIRE(!res.has_value());
+    REQUIRE(std::get<0>(res.error()) == 1);
+    REQUIRE(!std::get<1>(res.error()).has_value());
+}
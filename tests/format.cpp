@@ -0,0 +1,94 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <string>
+#include <utility>
+
+#if __has_include(<format>)
+#include <format>
+#endif
+
+#if !defined(__cpp_lib_format) && defined(SUMTY_TEST_FMT)
+#include <fmt/format.h>
+#include <fmt/xchar.h>
+#endif
+
+#include "sumty/error_set.hpp"
+#include "sumty/format.hpp" // IWYU pragma: associated
+#include "sumty/option.hpp"
+#include "sumty/result.hpp"
+#include "sumty/utils.hpp"
+#include "sumty/variant.hpp"
+
+using namespace sumty;
+
+#if defined(__cpp_lib_format)
+namespace fmtlib = std;
+#elif defined(FMT_VERSION)
+namespace fmtlib = fmt;
+#endif
+
+#if defined(__cpp_lib_format) || defined(FMT_VERSION)
+
+TEST_CASE("format variant", "[format]") {
+    const variant<int, std::string, void> v1{std::in_place_index<0>, 255};
+    const variant<int, std::string, void> v2{std::in_place_index<1>, "hello"};
+    const variant<int, std::string, void> v3{std::in_place_index<2>};
+    REQUIRE(fmtlib::format("{}", v1) == "255");
+    REQUIRE(fmtlib::format("{}", v2) == "hello");
+    REQUIRE(fmtlib::format("{}", v3) == "()");
+    REQUIRE(fmtlib::format("{:>6}", v1) == "   255");
+    REQUIRE(fmtlib::format("{:>6}", v2) == " hello");
+    REQUIRE(fmtlib::format("{:x|>7|}", v1) == "ff");
+    REQUIRE(fmtlib::format("{:x|>7|}", v2) == "  hello");
+    REQUIRE(fmtlib::format("[{:x|>7|}]", v3) == "[()]");
+    REQUIRE_THROWS(fmtlib::vformat("{:x|>7}", fmtlib::make_format_args(v1)));
+    REQUIRE_THROWS(fmtlib::vformat("{:x|>7||}", fmtlib::make_format_args(v1)));
+    REQUIRE_THROWS(fmtlib::vformat("{:x}", fmtlib::make_format_args(v1)));
+}
+
+TEST_CASE("format option", "[format]") {
+    int value = 42;
+    const option<int> opt1{};
+    const option<int> opt2{value};
+    const option<int&> opt3{&value};
+    const option<void> opt4{std::in_place};
+    REQUIRE(fmtlib::format("{}", opt1) == "none");
+    REQUIRE(fmtlib::format("{}", opt2) == "some(42)");
+    REQUIRE(fmtlib::format("{:04}", opt3) == "some(0042)");
+    REQUIRE(fmtlib::format("{}", opt4) == "some()");
+    REQUIRE(fmtlib::format("{:|^6}", opt2) == "some(||42||)");
+    REQUIRE(fmtlib::format("{}", none) == "none");
+}
+
+TEST_CASE("format result", "[format]") {
+    const result<int, std::string> res1{255};
+    const result<int, std::string> res2{in_place_error, "oops"};
+    const result<void, void> res3{};
+    const result<void, void> res4{in_place_error};
+    REQUIRE(fmtlib::format("{}", res1) == "ok(255)");
+    REQUIRE(fmtlib::format("{}", res2) == "error(oops)");
+    REQUIRE(fmtlib::format("{:#x|.2}", res1) == "ok(0xff)");
+    REQUIRE(fmtlib::format("{:#x|.2}", res2) == "error(oo)");
+    REQUIRE(fmtlib::format("{} {}", res3, res4) == "ok() error()");
+    REQUIRE(fmtlib::format("{}", ok<int>(3)) == "ok(3)");
+    REQUIRE(fmtlib::format("{:>3}", error<std::string>("e")) == "error(  e)");
+}
+
+TEST_CASE("format error_set", "[format]") {
+    const error_set<int, std::string> err1{std::in_place_index<0>, 7};
+    const error_set<int, std::string> err2{std::in_place_index<1>, "bad"};
+    REQUIRE(fmtlib::format("{}", err1) == "7");
+    REQUIRE(fmtlib::format("{:03|}", err1) == "007");
+    REQUIRE(fmtlib::format("{:03|}", err2) == "bad");
+}
+
+TEST_CASE("format wide", "[format]") {
+    const result<int, void> res{42};
+    REQUIRE(fmtlib::format(L"{:>4}", res) == L"ok(  42)");
+}
+
+#else
+
+TEST_CASE("format", "[format]") { SKIP("neither std::format nor fmt is available"); }
+
+#endif
@@ -0,0 +1,110 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <string>
+#include <utility>
+
+#include "sumty/fsm.hpp" // IWYU pragma: associated
+#include "sumty/utils.hpp"
+#include "sumty/variant.hpp"
+
+using namespace sumty;
+
+namespace {
+
+struct idle {};
+
+struct connecting {
+    std::string host;
+    int attempts;
+};
+
+struct connected {
+    std::string host;
+};
+
+struct connect {
+    std::string host;
+};
+
+struct retry {};
+
+struct established {};
+
+struct drop {};
+
+using states = variant<idle, connecting, connected>;
+using events = variant<connect, retry, established, drop>;
+
+auto make_transitions() {
+    return overload(
+        [](idle&, connect&& ev) { return connecting{std::move(ev.host), 1}; },
+        [](connecting& s, retry&&) { ++s.attempts; },
+        [](connecting& s, established&&) { return connected{std::move(s.host)}; },
+        [](auto&, drop&&) { return states{idle{}}; });
+}
+
+using transitions = decltype(make_transitions());
+
+} // namespace
+
+TEST_CASE("fsm transitions", "[fsm]") {
+    fsm<states, events, transitions> machine{idle{}, make_transitions()};
+    REQUIRE(machine.index() == 0);
+
+    REQUIRE(!machine.dispatch(established{}));
+    REQUIRE(machine.index() == 0);
+
+    REQUIRE(machine.dispatch(connect{"example.com"}));
+    REQUIRE(machine.index() == 1);
+    REQUIRE(get<1>(machine.state()).host == "example.com");
+
+    REQUIRE(machine.dispatch(retry{}));
+    REQUIRE(machine.dispatch(retry{}));
+    REQUIRE(get<1>(machine.state()).attempts == 3);
+
+    REQUIRE(machine.dispatch(established{}));
+    REQUIRE(machine.index() == 2);
+    REQUIRE(get<2>(machine.state()).host == "example.com");
+
+    REQUIRE(!machine.dispatch(connect{"other.com"}));
+    REQUIRE(machine.dispatch(drop{}));
+    REQUIRE(machine.index() == 0);
+}
+
+TEST_CASE("fsm counters", "[fsm]") {
+    fsm<states, events, transitions, true> machine{idle{}, make_transitions()};
+    machine.dispatch(connect{"a"});
+    machine.dispatch(retry{});
+    machine.dispatch(retry{});
+    machine.dispatch(drop{});
+    machine.dispatch(drop{});
+    REQUIRE(machine.transition_count(0, 0) == 1);
+    REQUIRE(machine.transition_count(1, 1) == 2);
+    REQUIRE(machine.transition_count(1, 3) == 1);
+    REQUIRE(machine.transition_count(0, 3) == 1);
+    REQUIRE(machine.transition_count(2, 2) == 0);
+}
+
+TEST_CASE("fsm large table", "[fsm]") {
+    struct s0 {};
+    struct s1 {};
+    struct s2 {};
+    struct s3 {};
+    struct s4 {};
+    struct next {};
+    struct reset {};
+    struct noop {};
+    auto trans = overload([](s0&, next&&) { return s1{}; },
+                          [](s1&, next&&) { return s2{}; },
+                          [](s2&, next&&) { return s3{}; },
+                          [](s3&, next&&) { return s4{}; },
+                          [](auto&, reset&&) { return s0{}; });
+    fsm<variant<s0, s1, s2, s3, s4>, variant<next, reset, noop>, decltype(trans)> machine{
+        s0{}, trans};
+    for (int i = 0; i < 4; ++i) { REQUIRE(machine.dispatch(next{})); }
+    REQUIRE(machine.index() == 4);
+    REQUIRE(!machine.dispatch(next{}));
+    REQUIRE(!machine.dispatch(noop{}));
+    REQUIRE(machine.dispatch(reset{}));
+    REQUIRE(machine.index() == 0);
+}
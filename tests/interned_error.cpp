@@ -0,0 +1,74 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "sumty/error_set.hpp"
+#include "sumty/interned_error.hpp" // IWYU pragma: associated
+#include "sumty/result.hpp"
+
+using namespace sumty;
+
+namespace {
+
+result<int, interned_error> parse(std::string_view str) {
+    if (str.empty()) { return error<interned_error>("empty input"); }
+    return static_cast<int>(str.size());
+}
+
+} // namespace
+
+TEST_CASE("interned_error size", "[interned_error]") {
+    STATIC_CHECK(sizeof(interned_error) == sizeof(uint32_t));
+    STATIC_CHECK(sizeof(result<int, interned_error>) == sizeof(result<int, uint32_t>));
+}
+
+TEST_CASE("interned_error dedup", "[interned_error]") {
+    const interned_error err1 = "interned message";
+    const interned_error err2 = std::string("interned message");
+    const interned_error err3 = "other interned message";
+    REQUIRE(err1 == err2);
+    REQUIRE(err1.id() == err2.id());
+    REQUIRE(err1 != err3);
+    REQUIRE(err1.view() == "interned message");
+    REQUIRE(err1.view().data() == err2.view().data());
+    REQUIRE(std::string_view(err3.c_str()) == "other interned message");
+
+    const interned_error empty{};
+    REQUIRE(empty.empty());
+    REQUIRE(empty.view().empty());
+    REQUIRE(interned_error("") == empty);
+}
+
+TEST_CASE("interned_error result", "[interned_error]") {
+    auto res1 = parse("");
+    auto res2 = parse("");
+    REQUIRE(!res1.has_value());
+    REQUIRE(res1.error() == res2.error());
+    REQUIRE(res1.error().view() == "empty input");
+    REQUIRE(*parse("abc") == 3);
+
+    error_set<int, interned_error> err = interned_error("set error");
+    REQUIRE(get<interned_error>(err).view() == "set error");
+}
+
+TEST_CASE("interned_error threads", "[interned_error]") {
+    static constexpr int THREADS = 4;
+    static constexpr int MESSAGES = 64;
+    std::vector<std::vector<uint32_t>> ids(THREADS);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < THREADS; ++t) {
+        threads.emplace_back([&ids, t] {
+            for (int i = 0; i < MESSAGES; ++i) {
+                ids[static_cast<size_t>(t)].push_back(
+                    interned_error("threaded message " + std::to_string(i)).id());
+            }
+        });
+    }
+    for (auto& thread : threads) { thread.join(); }
+    for (int t = 1; t < THREADS; ++t) { REQUIRE(ids[static_cast<size_t>(t)] == ids[0]); }
+    REQUIRE(interned_error("threaded message 7").id() == ids[0][7]);
+}
@@ -0,0 +1,187 @@
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <list>
+#include <numeric>
+#include <ranges>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "sumty/iter.hpp" // IWYU pragma: associated
+#include "sumty/option.hpp"
+
+using namespace sumty;
+
+TEST_CASE("iter from lvalue range yields references", "[iter]") {
+    std::vector<int> values{1, 2, 3};
+    auto it = iter::from(values);
+    STATIC_REQUIRE(std::is_same_v<iter::item_t<decltype(it)>, int&>);
+    STATIC_REQUIRE(sizeof(decltype(it.next())) == sizeof(int*));
+
+    while (option<int&> value = it.next()) { *value *= 10; }
+    REQUIRE(values == std::vector<int>{10, 20, 30});
+    REQUIRE(!it.next().has_value());
+}
+
+TEST_CASE("iter from rvalue range owns and yields values", "[iter]") {
+    auto it = iter::from(std::vector<std::string>{"a", "b"});
+    STATIC_REQUIRE(std::is_same_v<iter::item_t<decltype(it)>, std::string>);
+
+    REQUIRE(it.next() == "a");
+    auto moved = std::move(it);
+    REQUIRE(moved.next() == "b");
+    REQUIRE(!moved.next().has_value());
+}
+
+TEST_CASE("iter from prvalue view yields values", "[iter]") {
+    auto it = iter::from(std::views::iota(0, 4));
+    STATIC_REQUIRE(std::is_same_v<iter::item_t<decltype(it)>, int>);
+    REQUIRE(it.count() == 4);
+}
+
+TEST_CASE("iter from_fn", "[iter]") {
+    int n = 0;
+    auto it = iter::from_fn([&n]() -> option<int> {
+        if (n == 3) { return none; }
+        return n++;
+    });
+    REQUIRE(it.collect<std::vector<int>>() == std::vector<int>{0, 1, 2});
+}
+
+TEST_CASE("iter map", "[iter]") {
+    std::vector<int> values{1, 2, 3};
+    auto doubled = iter::from(values).map([](int& v) { return v * 2; });
+    REQUIRE(doubled.collect<std::vector<int>>() == std::vector<int>{2, 4, 6});
+
+    struct point {
+        int x;
+        int y;
+    };
+    std::vector<point> points{{1, 2}, {3, 4}};
+    auto ys = iter::from(points).map([](point& p) -> int& { return p.y; });
+    STATIC_REQUIRE(std::is_same_v<iter::item_t<decltype(ys)>, int&>);
+    ys.for_each([](int& y) { y = -y; });
+    REQUIRE(points[0].y == -2);
+    REQUIRE(points[1].y == -4);
+}
+
+TEST_CASE("iter filter", "[iter]") {
+    std::vector<int> values{1, 2, 3, 4, 5, 6};
+    auto evens = iter::from(values).filter([](int v) { return v % 2 == 0; });
+    REQUIRE(evens.collect<std::vector<int>>() == std::vector<int>{2, 4, 6});
+}
+
+TEST_CASE("iter take", "[iter]") {
+    int calls = 0;
+    auto it = iter::from_fn([&calls]() -> option<int> { return calls++; }).take(3);
+    REQUIRE(it.collect<std::vector<int>>() == std::vector<int>{0, 1, 2});
+    REQUIRE(calls == 3);
+    REQUIRE(!it.next().has_value());
+}
+
+TEST_CASE("iter chain", "[iter]") {
+    std::vector<int> first{1, 2};
+    std::list<int> second{3, 4};
+    auto it = iter::from(first).chain(iter::from(second));
+    REQUIRE(it.collect<std::vector<int>>() == std::vector<int>{1, 2, 3, 4});
+}
+
+TEST_CASE("iter zip", "[iter]") {
+    std::vector<int> keys{1, 2, 3};
+    std::vector<std::string> names{"one", "two"};
+    auto it = iter::from(keys).zip(iter::from(names));
+    STATIC_REQUIRE(
+        std::is_same_v<iter::item_t<decltype(it)>, std::pair<int&, std::string&>>);
+
+    auto first = it.next();
+    REQUIRE(first.has_value());
+    REQUIRE(&first->first == &keys[0]);
+    REQUIRE(&first->second == &names[0]);
+    REQUIRE(it.next().has_value());
+    REQUIRE(!it.next().has_value());
+}
+
+TEST_CASE("iter flat_map", "[iter]") {
+    std::vector<std::vector<int>> nested{{1, 2}, {}, {3}};
+    auto refs = iter::from(nested).flat_map([](std::vector<int>& v) -> std::vector<int>& {
+        return v;
+    });
+    STATIC_REQUIRE(std::is_same_v<iter::item_t<decltype(refs)>, int&>);
+    REQUIRE(refs.collect<std::vector<int>>() == std::vector<int>{1, 2, 3});
+
+    std::vector<int> counts{2, 0, 3};
+    auto owned = iter::from(counts).flat_map(
+        [](int n) { return std::vector<int>(static_cast<size_t>(n), n); });
+    REQUIRE(owned.collect<std::vector<int>>() == std::vector<int>{2, 2, 3, 3, 3});
+
+    auto ranges = iter::from(counts).flat_map(
+        [](int n) { return iter::from(std::views::iota(0, n)); });
+    REQUIRE(ranges.collect<std::vector<int>>() == std::vector<int>{0, 1, 0, 1, 2});
+}
+
+TEST_CASE("iter by_ref", "[iter]") {
+    std::vector<int> values{1, 2, 3, 4, 5};
+    auto it = iter::from(values);
+    REQUIRE(it.by_ref().take(2).fold(0, std::plus{}) == 3);
+    REQUIRE(it.fold(0, std::plus{}) == 12);
+}
+
+TEST_CASE("iter as_range", "[iter]") {
+    std::vector<int> values{5, 1, 4, 2, 3};
+    auto view = iter::from(values).filter([](int v) { return v > 1; }).as_range();
+    STATIC_REQUIRE(std::ranges::input_range<decltype(view)>);
+    STATIC_REQUIRE(std::ranges::view<decltype(view)>);
+
+    std::vector<int> out{};
+    for (int& v : view) { out.push_back(v); }
+    REQUIRE(out == std::vector<int>{5, 4, 2, 3});
+
+    auto squares = iter::from(values).as_range() |
+                   std::views::transform([](int v) { return v * v; });
+    REQUIRE(std::ranges::max(squares) == 25);
+}
+
+TEST_CASE("iter benchmarks", "[iter][!benchmark]") {
+    std::vector<int> values(1 << 16);
+    std::iota(values.begin(), values.end(), 0);
+    std::vector<std::vector<int>> nested(256, std::vector<int>(256));
+    for (auto& inner : nested) { std::iota(inner.begin(), inner.end(), 0); }
+
+    BENCHMARK("iter filter/map/take") {
+        return iter::from(values)
+            .filter([](int v) { return v % 3 != 0; })
+            .map([](int v) { return static_cast<long>(v) * v; })
+            .filter([](long v) { return v % 5 != 0; })
+            .take(values.size() / 2)
+            .fold(0L, std::plus{});
+    };
+
+    BENCHMARK("std::views filter/transform/take") {
+        long sum = 0;
+        auto view = values | std::views::filter([](int v) { return v % 3 != 0; }) |
+                    std::views::transform([](int v) { return static_cast<long>(v) * v; }) |
+                    std::views::filter([](long v) { return v % 5 != 0; }) |
+                    std::views::take(values.size() / 2);
+        for (long v : view) { sum += v; }
+        return sum;
+    };
+
+    BENCHMARK("iter flat_map/filter") {
+        return iter::from(nested)
+            .flat_map([](std::vector<int>& v) -> std::vector<int>& { return v; })
+            .filter([](int v) { return v % 7 != 0; })
+            .fold(0L, std::plus{});
+    };
+
+    BENCHMARK("std::views join/filter") {
+        long sum = 0;
+        auto view = nested | std::views::join |
+                    std::views::filter([](int v) { return v % 7 != 0; });
+        for (int v : view) { sum += v; }
+        return sum;
+    };
+}
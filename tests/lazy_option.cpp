@@ -0,0 +1,80 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "sumty/lazy_option.hpp" // IWYU pragma: associated
+#include "sumty/result.hpp"
+
+using namespace sumty;
+
+TEST_CASE("lazy_option get_or_init", "[lazy_option]") {
+    lazy_option<std::string> lazy{};
+    REQUIRE(!lazy.is_initialized());
+    REQUIRE(!lazy.get().has_value());
+    int calls = 0;
+    auto& val1 = lazy.get_or_init([&calls] {
+        ++calls;
+        return std::string("hello");
+    });
+    auto& val2 = lazy.get_or_init([&calls] {
+        ++calls;
+        return std::string("world");
+    });
+    REQUIRE(calls == 1);
+    REQUIRE(&val1 == &val2);
+    REQUIRE(val1 == "hello");
+    REQUIRE(lazy.is_initialized());
+    REQUIRE(&*lazy.get() == &val1);
+    const auto& clazy = lazy;
+    REQUIRE(clazy.get().value() == "hello");
+}
+
+TEST_CASE("lazy_option throwing initializer", "[lazy_option]") {
+    lazy_option<int> lazy{};
+    REQUIRE_THROWS_AS(lazy.get_or_init([]() -> int { throw std::runtime_error("oops"); }),
+                      std::runtime_error);
+    REQUIRE(!lazy.is_initialized());
+    REQUIRE(lazy.get_or_init([] { return 5; }) == 5);
+}
+
+TEST_CASE("lazy_option get_or_try_init", "[lazy_option]") {
+    lazy_option<int> lazy{};
+    auto res1 = lazy.get_or_try_init([]() -> result<int, std::string> {
+        return error<std::string>("not yet");
+    });
+    REQUIRE(!res1.has_value());
+    REQUIRE(res1.error() == "not yet");
+    REQUIRE(!lazy.is_initialized());
+
+    auto res2 = lazy.get_or_try_init([]() -> result<int, std::string> { return 7; });
+    REQUIRE(res2.has_value());
+    REQUIRE(*res2 == 7);
+    REQUIRE(&*res2 == &*lazy.get());
+
+    auto res3 = lazy.get_or_try_init([]() -> result<int, std::string> {
+        return error<std::string>("unused");
+    });
+    REQUIRE(*res3 == 7);
+}
+
+TEST_CASE("lazy_option concurrent init", "[lazy_option]") {
+    lazy_option<std::vector<int>> lazy{};
+    std::atomic<int> calls{0};
+    std::vector<std::thread> threads;
+    std::vector<const std::vector<int>*> seen(8, nullptr);
+    for (size_t i = 0; i < seen.size(); ++i) {
+        threads.emplace_back([&lazy, &calls, &seen, i] {
+            seen[i] = &lazy.get_or_init([&calls] {
+                ++calls;
+                return std::vector<int>{1, 2, 3};
+            });
+        });
+    }
+    for (auto& thread : threads) { thread.join(); }
+    REQUIRE(calls.load() == 1);
+    for (const auto* ptr : seen) { REQUIRE(ptr == &*lazy.get()); }
+}
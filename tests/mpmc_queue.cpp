@@ -0,0 +1,147 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "sumty/mpmc_queue.hpp" // IWYU pragma: associated
+#include "sumty/utils.hpp"
+#include "sumty/variant.hpp"
+
+using namespace sumty;
+
+namespace {
+
+struct move_counter {
+    int* moves;
+
+    explicit move_counter(int* counter) noexcept : moves(counter) {}
+
+    move_counter(const move_counter&) = delete;
+
+    move_counter(move_counter&& other) noexcept : moves(other.moves) { ++*moves; }
+
+    move_counter& operator=(const move_counter&) = delete;
+
+    move_counter& operator=(move_counter&&) = delete;
+
+    ~move_counter() noexcept = default;
+};
+
+} // namespace
+
+TEST_CASE("mpmc_queue push pop", "[mpmc_queue]") {
+    mpmc_queue<variant<int, std::string, void>> queue(3);
+    REQUIRE(queue.capacity() == 4);
+    REQUIRE(!queue.try_pop().has_value());
+
+    REQUIRE(queue.try_push(variant<int, std::string, void>(42)));
+    REQUIRE(queue.try_push(variant<int, std::string, void>(std::string("hello"))));
+    REQUIRE(queue.try_emplace(std::in_place_index<2>));
+    REQUIRE(queue.try_emplace(std::in_place_index<0>, 7));
+
+    variant<int, std::string, void> extra(std::string("extra"));
+    REQUIRE(!queue.try_push(std::move(extra)));
+    REQUIRE(get<1>(extra) == "extra");
+
+    auto msg1 = queue.try_pop();
+    REQUIRE(get<0>(*msg1) == 42);
+    auto msg2 = queue.try_pop();
+    REQUIRE(get<1>(*msg2) == "hello");
+    auto msg3 = queue.try_pop();
+    REQUIRE(msg3->index() == 2);
+    REQUIRE(queue.try_push(extra));
+    REQUIRE(get<0>(*queue.try_pop()) == 7);
+    REQUIRE(get<1>(*queue.try_pop()) == "extra");
+    REQUIRE(!queue.try_pop().has_value());
+}
+
+TEST_CASE("mpmc_queue reference alternative", "[mpmc_queue]") {
+    int value = 0;
+    mpmc_queue<variant<int&, void>> queue(2);
+    REQUIRE(queue.try_emplace(std::in_place_index<0>, value));
+    auto msg = queue.try_pop();
+    REQUIRE(&get<0>(*msg) == &value);
+}
+
+TEST_CASE("mpmc_queue single move", "[mpmc_queue]") {
+    int push_moves = 0;
+    mpmc_queue<variant<move_counter, void>> queue(2);
+    variant<move_counter, void> msg(std::in_place_index<0>, &push_moves);
+    REQUIRE(queue.try_push(std::move(msg)));
+    REQUIRE(push_moves == 1);
+    auto popped = queue.try_pop();
+    REQUIRE(push_moves == 2);
+    REQUIRE(popped.has_value());
+
+    int batch_moves = 0;
+    REQUIRE(queue.try_emplace(std::in_place_index<0>, &batch_moves));
+    std::array<variant<move_counter, void>, 1> out{
+        variant<move_counter, void>(std::in_place_index<1>)};
+    REQUIRE(queue.try_pop_batch(out.data(), 1) == 1);
+    REQUIRE(out[0].index() == 0);
+    REQUIRE(batch_moves == 1);
+}
+
+TEST_CASE("mpmc_queue destroys remaining messages", "[mpmc_queue]") {
+    auto shared = std::make_shared<int>(0);
+    {
+        mpmc_queue<variant<std::shared_ptr<int>, void>> queue(4);
+        REQUIRE(queue.try_emplace(std::in_place_index<0>, shared));
+        REQUIRE(queue.try_emplace(std::in_place_index<0>, shared));
+        REQUIRE(shared.use_count() == 3);
+    }
+    REQUIRE(shared.use_count() == 1);
+}
+
+TEST_CASE("mpmc_queue batch pop", "[mpmc_queue]") {
+    mpmc_queue<variant<int, void>> queue(8);
+    for (int i = 0; i < 5; ++i) { REQUIRE(queue.try_emplace(std::in_place_index<0>, i)); }
+    std::vector<variant<int, void>> out;
+    REQUIRE(queue.try_pop_batch(std::back_inserter(out), 0) == 0);
+    REQUIRE(queue.try_pop_batch(std::back_inserter(out), 3) == 3);
+    REQUIRE(queue.try_pop_batch(std::back_inserter(out), 8) == 2);
+    REQUIRE(queue.try_pop_batch(std::back_inserter(out), 8) == 0);
+    REQUIRE(out.size() == 5);
+    for (int i = 0; i < 5; ++i) { REQUIRE(get<0>(out[static_cast<size_t>(i)]) == i); }
+}
+
+TEST_CASE("mpmc_queue concurrent", "[mpmc_queue]") {
+    static constexpr uint64_t PRODUCERS = 4;
+    static constexpr uint64_t CONSUMERS = 4;
+    static constexpr uint64_t PER_PRODUCER = 10000;
+    mpmc_queue<variant<uint64_t, std::string>> queue(64);
+    std::atomic<uint64_t> sum{0};
+    std::atomic<uint64_t> received{0};
+    std::vector<std::thread> threads;
+    for (uint64_t p = 0; p < PRODUCERS; ++p) {
+        threads.emplace_back([&queue] {
+            for (uint64_t i = 1; i <= PER_PRODUCER; ++i) {
+                while (!queue.try_emplace(std::in_place_index<0>, i)) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    for (uint64_t c = 0; c < CONSUMERS; ++c) {
+        threads.emplace_back([&queue, &sum, &received] {
+            std::vector<variant<uint64_t, std::string>> batch;
+            while (received.load() < PRODUCERS * PER_PRODUCER) {
+                batch.clear();
+                const auto count = queue.try_pop_batch(std::back_inserter(batch), 16);
+                for (auto& msg : batch) { sum += get<0>(msg); }
+                received += count;
+                if (count == 0) { std::this_thread::yield(); }
+            }
+        });
+    }
+    for (auto& thread : threads) { thread.join(); }
+    REQUIRE(received.load() == PRODUCERS * PER_PRODUCER);
+    REQUIRE(sum.load() == PRODUCERS * PER_PRODUCER * (PER_PRODUCER + 1) / 2);
+}
@@ -0,0 +1,146 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+
+#include "sumty/offset_ref.hpp" // IWYU pragma: associated
+#include "sumty/option.hpp"
+
+using namespace sumty;
+
+namespace {
+
+struct node {
+    int value;
+    option<offset_ref<node>> next;
+};
+
+struct test_arena {
+    // NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+    static inline std::byte* mapping = nullptr;
+
+    static std::byte* base() noexcept { return mapping; }
+};
+
+struct rel_node {
+    int value;
+    option<rel32_ref<rel_node, test_arena>> next;
+};
+
+} // namespace
+
+TEST_CASE("offset_ref size", "[offset_ref]") {
+    STATIC_REQUIRE(sizeof(offset_ref<int>) == sizeof(std::ptrdiff_t));
+    STATIC_REQUIRE(sizeof(option<offset_ref<int>>) == sizeof(offset_ref<int>));
+    STATIC_REQUIRE(sizeof(option<offset_ref<node>>) == sizeof(std::ptrdiff_t));
+}
+
+TEST_CASE("offset_ref get", "[offset_ref]") {
+    int value = 42;
+    offset_ref<int> ref = value;
+    REQUIRE(&ref.get() == &value);
+    REQUIRE(&*ref == &value);
+    int& unwrapped = ref;
+    REQUIRE(&unwrapped == &value);
+    ref.get() = 24;
+    REQUIRE(value == 24);
+}
+
+TEST_CASE("offset_ref copy", "[offset_ref]") {
+    int value1 = 1;
+    int value2 = 2;
+    offset_ref<int> ref1 = value1;
+    auto ref2 = std::make_unique<offset_ref<int>>(ref1);
+    REQUIRE(&ref2->get() == &value1);
+    *ref2 = offset_ref<int>(value2);
+    REQUIRE(&ref2->get() == &value2);
+    ref1 = *ref2;
+    REQUIRE(&ref1.get() == &value2);
+}
+
+TEST_CASE("offset_ref option", "[offset_ref]") {
+    int value = 42;
+    option<offset_ref<int>> opt{};
+    REQUIRE(!opt.has_value());
+    opt = offset_ref<int>(value);
+    REQUIRE(opt.has_value());
+    REQUIRE(&opt->get() == &value);
+    auto copy = opt;
+    REQUIRE(copy.has_value());
+    REQUIRE(&copy->get() == &value);
+    opt = none;
+    REQUIRE(!opt.has_value());
+    copy = opt;
+    REQUIRE(!copy.has_value());
+    option<offset_ref<int>> moved = std::move(opt);
+    REQUIRE(!moved.has_value());
+}
+
+TEST_CASE("offset_ref relocated segment", "[offset_ref]") {
+    alignas(node) std::array<std::byte, sizeof(node) * 3> segment1{};
+    alignas(node) std::array<std::byte, sizeof(node) * 3> segment2{};
+    auto* nodes = reinterpret_cast<node*>(segment1.data());
+    std::construct_at(&nodes[2], 3, none);
+    std::construct_at(&nodes[1], 2, nodes[2]);
+    std::construct_at(&nodes[0], 1, nodes[1]);
+    std::memcpy(segment2.data(), segment1.data(), segment1.size());
+
+    const auto* moved = reinterpret_cast<const node*>(segment2.data());
+    int sum = 0;
+    for (const node* cur = moved; cur != nullptr;
+         cur = cur->next.has_value() ? &cur->next->get() : nullptr) {
+        REQUIRE(cur >= moved);
+        REQUIRE(cur < moved + 3);
+        sum += cur->value;
+    }
+    REQUIRE(sum == 6);
+}
+
+TEST_CASE("rel32_ref size", "[rel32_ref]") {
+    using ref_t = rel32_ref<rel_node, test_arena>;
+    STATIC_REQUIRE(sizeof(ref_t) == sizeof(uint32_t));
+    STATIC_REQUIRE(sizeof(option<ref_t>) == sizeof(uint32_t));
+    STATIC_REQUIRE(sizeof(rel_node) == 2 * sizeof(uint32_t));
+    STATIC_REQUIRE(std::is_trivially_copyable_v<ref_t>);
+    STATIC_REQUIRE(std::is_trivially_copyable_v<option<ref_t>>);
+}
+
+TEST_CASE("rel32_ref get", "[rel32_ref]") {
+    alignas(rel_node) std::array<std::byte, sizeof(rel_node) * 4> arena{};
+    test_arena::mapping = arena.data();
+    auto* nodes = reinterpret_cast<rel_node*>(arena.data());
+    std::construct_at(&nodes[3], 4, none);
+    std::construct_at(&nodes[2], 3, nodes[3]);
+    std::construct_at(&nodes[1], 2, nodes[2]);
+    std::construct_at(&nodes[0], 1, nodes[1]);
+    REQUIRE(nodes[0].next->offset() == sizeof(rel_node));
+    REQUIRE(&nodes[0].next->get() == &nodes[1]);
+    REQUIRE(nodes[2].next.has_value());
+    REQUIRE(!nodes[3].next.has_value());
+
+    nodes[1].next = none;
+    REQUIRE(!nodes[1].next.has_value());
+    nodes[1].next = nodes[0].next;
+    REQUIRE((*nodes[1].next)->value == 2);
+    test_arena::mapping = nullptr;
+}
+
+TEST_CASE("rel32_ref relocated arena", "[rel32_ref]") {
+    alignas(rel_node) std::array<std::byte, sizeof(rel_node) * 2> arena1{};
+    alignas(rel_node) std::array<std::byte, sizeof(rel_node) * 2> arena2{};
+    test_arena::mapping = arena1.data();
+    auto* nodes = reinterpret_cast<rel_node*>(arena1.data());
+    std::construct_at(&nodes[1], 2, none);
+    std::construct_at(&nodes[0], 1, nodes[1]);
+    std::memcpy(arena2.data(), arena1.data(), arena1.size());
+
+    test_arena::mapping = arena2.data();
+    const auto* moved = reinterpret_cast<const rel_node*>(arena2.data());
+    REQUIRE(&moved[0].next->get() == &moved[1]);
+    REQUIRE(moved[0].next->get().value == 2);
+    test_arena::mapping = nullptr;
+}
@@ -0,0 +1,66 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <memory>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "sumty/exceptions.hpp"
+#include "sumty/oneshot.hpp" // IWYU pragma: associated
+#include "sumty/result.hpp"
+
+using namespace sumty;
+
+TEST_CASE("oneshot set and wait", "[oneshot]") {
+    oneshot<int, std::string> reply{};
+    REQUIRE(!reply.ready());
+    REQUIRE(!reply.try_take().has_value());
+    REQUIRE(reply.set(42));
+    REQUIRE(!reply.set(24));
+    REQUIRE(reply.ready());
+    auto res = reply.wait();
+    REQUIRE(res.has_value());
+    REQUIRE(*res == 42);
+    REQUIRE(!reply.ready());
+    REQUIRE_THROWS_AS(static_cast<void>(reply.wait()), bad_option_access);
+}
+
+TEST_CASE("oneshot error", "[oneshot]") {
+    oneshot<void, std::string> reply{};
+    REQUIRE(reply.set(error<std::string>("failed")));
+    auto res = reply.try_take();
+    REQUIRE(res.has_value());
+    REQUIRE(res->error() == "failed");
+}
+
+TEST_CASE("oneshot move only", "[oneshot]") {
+    oneshot<std::unique_ptr<int>> reply{};
+    REQUIRE(reply.set(std::make_unique<int>(7)));
+    auto res = reply.wait();
+    REQUIRE(**res == 7);
+}
+
+TEST_CASE("oneshot across threads", "[oneshot]") {
+    oneshot<std::string> reply{};
+    std::thread producer([&reply] { reply.set(std::string("done")); });
+    auto res = reply.wait();
+    producer.join();
+    REQUIRE(*res == "done");
+}
+
+TEST_CASE("shared_oneshot", "[oneshot]") {
+    shared_oneshot<int, std::string> value{};
+    REQUIRE(!value.try_get().has_value());
+    std::vector<std::thread> readers;
+    std::vector<int> seen(4, 0);
+    for (size_t i = 0; i < seen.size(); ++i) {
+        readers.emplace_back([&value, &seen, i] { seen[i] = *value.wait(); });
+    }
+    REQUIRE(value.set(5));
+    REQUIRE(!value.set(6));
+    for (auto& reader : readers) { reader.join(); }
+    for (auto val : seen) { REQUIRE(val == 5); }
+    REQUIRE(value.ready());
+    REQUIRE(&*value.try_get() == &value.wait());
+}
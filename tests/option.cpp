@@ -1,8 +1,11 @@
 #include <catch2/catch_test_macros.hpp>
 #include <compare>
+#include <functional>
 #include <optional>
 #include <string>
 #include <type_traits>
+#include <unordered_set>
+#include <utility>
 
 #include "sumty/option.hpp" // IWYU pragma: associated
 #include "sumty/result.hpp"
@@ -530,3 +533,34 @@ TEST_CASE("option compare with nullptr", "[option]") {
     REQUIRE(nullptr <= opt);
     REQUIRE(!(nullptr >= opt));
 }
+
+TEST_CASE("option checked value", "[option]") {
+    static constexpr int VALUE = 42;
+    option<int> opt1{VALUE};
+    REQUIRE(opt1.value() == VALUE);
+    REQUIRE(get<1>(opt1) == VALUE);
+    REQUIRE_THROWS_AS(get<0>(opt1), bad_option_access);
+    option<int> opt2{};
+    REQUIRE_THROWS_AS(opt2.value(), bad_option_access);
+    REQUIRE_THROWS_AS(std::as_const(opt2).value(), bad_option_access);
+    REQUIRE_THROWS_AS(get<1>(opt2), bad_option_access);
+    REQUIRE_NOTHROW(get<0>(opt2));
+}
+
+TEST_CASE("option hash", "[option]") {
+    const std::hash<option<int>> hasher{};
+    REQUIRE(hasher(option<int>{42}) == hasher(option<int>{42}));
+    REQUIRE(hasher(option<int>{}) == hasher(option<int>{}));
+    REQUIRE(hasher(option<int>{}) != hasher(option<int>{0}));
+
+    int value = 42;
+    REQUIRE(std::hash<option<int&>>{}(option<int&>{&value}) == hasher(option<int>{42}));
+    REQUIRE(std::hash<option<void>>{}(option<void>{std::in_place}) !=
+            std::hash<option<void>>{}(option<void>{}));
+
+    std::unordered_set<option<std::string>> set{};
+    set.emplace("hello");
+    set.emplace();
+    set.emplace("hello");
+    REQUIRE(set.size() == 2);
+}
@@ -0,0 +1,122 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstddef>
+#include <iterator>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "sumty/pipeline.hpp" // IWYU pragma: associated
+#include "sumty/result.hpp"
+
+using namespace sumty;
+
+namespace {
+
+struct stage_error {
+    size_t stage;
+    std::string message;
+};
+
+auto collecting_sink(std::vector<stage_error>& errors) {
+    return [&errors](size_t stage, std::string&& message) {
+        errors.push_back(stage_error{stage, std::move(message)});
+    };
+}
+
+result<int, std::string> parse(std::string&& text) {
+    if (text.empty() || text.find_first_not_of("0123456789") != std::string::npos) {
+        return error<std::string>("bad number: " + text);
+    }
+    return std::stoi(text);
+}
+
+result<int, std::string> reject_odd(int&& value) {
+    if (value % 2 != 0) { return error<std::string>("odd: " + std::to_string(value)); }
+    return value;
+}
+
+result<std::string, std::string> format(int&& value) {
+    return std::to_string(value * 10);
+}
+
+} // namespace
+
+TEST_CASE("pipeline passes ok values through every stage", "[pipeline]") {
+    std::vector<stage_error> errors{};
+    auto pipe = make_pipeline<std::string>(collecting_sink(errors), parse, format);
+    STATIC_REQUIRE(decltype(pipe)::stage_count() == 2);
+
+    pipe.push("1");
+    pipe.push("2");
+    pipe.push("3");
+    pipe.close();
+
+    REQUIRE(pipe.pop() == "10");
+    REQUIRE(pipe.pop() == "20");
+    REQUIRE(pipe.pop() == "30");
+    REQUIRE(!pipe.pop().has_value());
+    REQUIRE(errors.empty());
+}
+
+TEST_CASE("pipeline diverts errors to the sink with the stage index", "[pipeline]") {
+    std::vector<stage_error> errors{};
+    {
+        auto pipe = make_pipeline<std::string>(collecting_sink(errors), parse, reject_odd,
+                                               format);
+        pipe.push("2");
+        pipe.push("x");
+        pipe.push("3");
+        pipe.push("4");
+        pipe.close();
+
+        std::vector<std::string> out{};
+        while (auto value = pipe.pop()) { out.push_back(*std::move(value)); }
+        REQUIRE(out == std::vector<std::string>{"20", "40"});
+    }
+
+    REQUIRE(errors.size() == 2);
+    REQUIRE(errors[0].stage == 0);
+    REQUIRE(errors[0].message == "bad number: x");
+    REQUIRE(errors[1].stage == 1);
+    REQUIRE(errors[1].message == "odd: 3");
+}
+
+TEST_CASE("pipeline applies backpressure with small queues", "[pipeline]") {
+    static constexpr int count = 10000;
+    std::vector<stage_error> errors{};
+    auto pipe = make_pipeline<int>(
+        4, collecting_sink(errors),
+        [](int&& value) { return result<int, std::string>{value}; }, reject_odd,
+        [](int&& value) { return result<long, std::string>{value / 2}; });
+
+    std::thread producer([&] {
+        std::vector<int> batch{};
+        for (int i = 0; i < count; ++i) {
+            batch.push_back(i);
+            if (batch.size() == 37) {
+                pipe.push_batch(batch.begin(), batch.end());
+                batch.clear();
+            }
+        }
+        pipe.push_batch(batch.begin(), batch.end());
+        pipe.close();
+    });
+
+    std::vector<long> out{};
+    while (pipe.pop_batch(std::back_inserter(out), 16) != 0) {}
+    producer.join();
+
+    REQUIRE(out.size() == count / 2);
+    for (size_t i = 0; i < out.size(); ++i) { REQUIRE(out[i] == static_cast<long>(i)); }
+    REQUIRE(errors.size() == count / 2);
+    for (const auto& err : errors) { REQUIRE(err.stage == 1); }
+}
+
+TEST_CASE("pipeline destructor discards unread output", "[pipeline]") {
+    std::vector<stage_error> errors{};
+    auto pipe = make_pipeline<std::string>(16, collecting_sink(errors), parse, format);
+    for (int i = 0; i < 8; ++i) { pipe.push(std::to_string(i)); }
+    REQUIRE(pipe.pop() == "0");
+}
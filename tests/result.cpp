@@ -1,8 +1,11 @@
 #include <catch2/catch_test_macros.hpp>
 
+#include <functional>
 #include <system_error>
 #include <type_traits>
+#include <unordered_set>
 #include <utility>
+#include <vector>
 
 #include "sumty/option.hpp"
 #include "sumty/result.hpp" // IWYU pragma: associated
@@ -369,3 +372,39 @@ TEST_CASE("result visit", "[result]") {
     });
     REQUIRE(val2 == VALUE);
 }
+
+TEST_CASE("result checked value", "[result]") {
+    static constexpr int VALUE = 42;
+    result<int, int> res1{VALUE};
+    REQUIRE(res1.value() == VALUE);
+    result<int, int> res2{error<int>(VALUE)};
+    REQUIRE_THROWS_AS(res2.value(), bad_result_access<int>);
+    try {
+        [[maybe_unused]] auto val = std::move(res2).value();
+        REQUIRE(false);
+    } catch (const bad_result_access<int>& ex) {
+        REQUIRE(ex.error() == VALUE);
+    }
+    result<int, void> res3{error<void>()};
+    REQUIRE_THROWS_AS(res3.value(), bad_result_access<void>);
+}
+
+TEST_CASE("result hash", "[result]") {
+    const std::hash<result<int, int>> hasher{};
+    REQUIRE(hasher(result<int, int>{42}) == hasher(result<int, int>{42}));
+    REQUIRE(hasher(result<int, int>{42}) != hasher(result<int, int>{error<int>(42)}));
+
+    REQUIRE(std::hash<result<void, int>>{}(result<void, int>{}) !=
+            std::hash<result<void, int>>{}(result<void, int>{error<int>(0)}));
+    REQUIRE(std::hash<result<int, void>>{}(result<int, void>{error<void>()}) ==
+            std::hash<result<int, void>>{}(result<int, void>{error<void>()}));
+
+    STATIC_CHECK(
+        !std::is_default_constructible_v<std::hash<result<int, std::vector<int>>>>);
+
+    std::unordered_set<result<int, std::error_code>> set{};
+    set.emplace(1);
+    set.emplace(error<std::error_code>(std::make_error_code(std::errc::invalid_argument)));
+    set.emplace(1);
+    REQUIRE(set.size() == 2);
+}
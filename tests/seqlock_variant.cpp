@@ -0,0 +1,100 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "sumty/seqlock_variant.hpp" // IWYU pragma: associated
+#include "sumty/utils.hpp"
+#include "sumty/variant.hpp"
+
+using namespace sumty;
+
+namespace {
+
+struct book {
+    std::array<uint64_t, 8> levels;
+};
+
+struct halted {
+    int64_t since;
+};
+
+} // namespace
+
+TEST_CASE("seqlock_variant traits", "[seqlock_variant]") {
+    STATIC_CHECK(is_snapshot_copyable_v<book>);
+    STATIC_CHECK(is_snapshot_copyable_v<int&>);
+    STATIC_CHECK(is_snapshot_copyable_v<void>);
+    STATIC_CHECK(!is_snapshot_copyable_v<std::vector<int>>);
+}
+
+TEST_CASE("seqlock_variant operations", "[seqlock_variant]") {
+    seqlock_variant<book, halted> market{};
+    REQUIRE(market.index() == 0);
+    REQUIRE(get<0>(market.load()).levels[0] == 0);
+    market.update([](variant<book, halted>& state) noexcept {
+        get<0>(state).levels[0] = 100;
+    });
+    REQUIRE(get<0>(market.load()).levels[0] == 100);
+    auto prev = market.exchange(halted{42});
+    REQUIRE(get<0>(prev).levels[0] == 100);
+    REQUIRE(market.index() == 1);
+    auto since = market.visit(
+        overload([](const book&) { return int64_t{0}; },
+                 [](const halted& h) { return h.since; }));
+    REQUIRE(since == 42);
+    market.store(book{});
+    REQUIRE(market.index() == 0);
+}
+
+TEST_CASE("seqlock_variant concurrent readers", "[seqlock_variant]") {
+    static constexpr uint64_t ITERATIONS = 10000;
+    seqlock_variant<book, halted> market{};
+    std::atomic<bool> torn{false};
+    std::thread writer([&market] {
+        for (uint64_t i = 1; i <= ITERATIONS; ++i) {
+            if (i % 100 == 0) {
+                market.store(halted{static_cast<int64_t>(i)});
+            } else {
+                market.update([i](variant<book, halted>& state) noexcept {
+                    if (state.index() != 0) { state = book{}; }
+                    get<0>(state).levels.fill(i);
+                });
+            }
+        }
+    });
+    std::vector<std::thread> readers;
+    for (int r = 0; r < 4; ++r) {
+        readers.emplace_back([&market, &torn] {
+            for (uint64_t i = 0; i < ITERATIONS; ++i) {
+                const bool consistent = market.visit(overload(
+                    [](const book& b) {
+                        for (auto level : b.levels) {
+                            if (level != b.levels[0]) { return false; }
+                        }
+                        return true;
+                    },
+                    [](const halted& h) { return h.since % 100 == 0; }));
+                if (!consistent) { torn = true; }
+            }
+        });
+    }
+    writer.join();
+    for (auto& reader : readers) { reader.join(); }
+    REQUIRE(!torn);
+    REQUIRE(market.index() == 1);
+}
+
+TEST_CASE("seqlock_variant wait", "[seqlock_variant]") {
+    seqlock_variant<book, halted> market{};
+    std::thread writer([&market] {
+        market.store(halted{1});
+        market.notify_all();
+    });
+    market.wait(book{});
+    writer.join();
+    REQUIRE(market.index() == 1);
+}
@@ -0,0 +1,223 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "sumty/error_set.hpp"
+#include "sumty/option.hpp"
+#include "sumty/result.hpp"
+#include "sumty/serialize.hpp" // IWYU pragma: associated
+#include "sumty/variant.hpp"
+
+using namespace sumty;
+
+namespace {
+
+struct timeout_error {
+    int millis;
+};
+
+struct refused_error {
+    uint16_t port;
+};
+
+struct closed_error {};
+
+enum class level : uint8_t { low, high };
+
+struct borrowed {
+    const char* name;
+};
+
+// not default constructible, and counts how it is constructed
+struct tracked {
+    std::string name;
+    int copies = 0;
+
+    explicit tracked(std::string str) : name(std::move(str)) {}
+
+    tracked(const tracked& other) : name(other.name), copies(other.copies + 1) {}
+
+    tracked(tracked&& other) noexcept = default;
+
+    ~tracked() = default;
+
+    tracked& operator=(const tracked&) = delete;
+    tracked& operator=(tracked&&) = delete;
+};
+
+template <typename T>
+std::vector<std::byte> encode(const T& value) {
+    std::vector<std::byte> buf;
+    serialize(vector_writer{buf}, value);
+    return buf;
+}
+
+template <typename T>
+result<T, decode_error> decode(const std::vector<std::byte>& buf) {
+    return deserialize<T>(span_reader{buf});
+}
+
+std::vector<std::byte> bytes(std::initializer_list<unsigned> values) {
+    std::vector<std::byte> ret;
+    for (const auto value : values) { ret.push_back(static_cast<std::byte>(value)); }
+    return ret;
+}
+
+} // namespace
+
+template <>
+struct sumty::serial_descriptor<timeout_error> {
+    static constexpr std::string_view name = "net.timeout";
+};
+
+template <>
+struct sumty::serial_descriptor<refused_error> {
+    static constexpr uint64_t id = 2;
+};
+
+template <>
+struct sumty::serial_descriptor<closed_error> {
+    static constexpr uint64_t id = 300;
+};
+
+template <>
+struct sumty::raw_serializable<timeout_error> : std::true_type {};
+
+template <>
+struct sumty::raw_serializable<refused_error> : std::true_type {};
+
+template <>
+struct sumty::raw_serializable<level> : std::true_type {
+    static constexpr bool valid(level value) noexcept {
+        return value == level::low || value == level::high;
+    }
+};
+
+template <>
+struct sumty::codec<tracked> {
+    static void encode(byte_writer auto& writer, const tracked& value) {
+        serialize(writer, value.name);
+    }
+
+    static result<tracked, decode_error> decode(byte_reader auto& reader) {
+        auto name = deserialize<std::string>(reader);
+        if (!name.has_value()) { return error<decode_error>(name.error()); }
+        return result<tracked, decode_error>{std::in_place, *std::move(name)};
+    }
+};
+
+TEST_CASE("serialize scalars and strings", "[serialize]") {
+    REQUIRE(encode(int32_t{0x01020304}).size() == 4);
+    REQUIRE(*decode<int32_t>(encode(int32_t{-7})) == -7);
+    REQUIRE(*decode<double>(encode(2.5)) == 2.5);
+    REQUIRE(*decode<bool>(encode(true)) == true);
+    REQUIRE(decode<bool>(bytes({2})).error() == decode_error::invalid_value);
+
+    const std::string long_str(10000, 'x');
+    REQUIRE(encode(std::string{"abc"}) == bytes({3, 'a', 'b', 'c'}));
+    REQUIRE(*decode<std::string>(encode(long_str)) == long_str);
+    REQUIRE(*decode<std::u16string>(encode(std::u16string{u"hi"})) == u"hi");
+    REQUIRE(decode<std::string>(bytes({0xff, 0xff, 0xff, 0xff, 0x0f, 'a'})).error() ==
+            decode_error::unexpected_end);
+
+    STATIC_CHECK(serializable<int>);
+    STATIC_CHECK(!serializable<int*>);
+    STATIC_CHECK(!serializable<long double>);
+    STATIC_CHECK(!serializable<std::string_view>);
+    STATIC_CHECK(!serializable<std::span<const int>>);
+    STATIC_CHECK(!serializable<borrowed>);
+    STATIC_CHECK(!serializable<decode_error>);
+    STATIC_CHECK(!serializable<option<int&>>);
+    STATIC_CHECK(!serializable<std::vector<int>>);
+}
+
+TEST_CASE("serialize opted in raw types", "[serialize]") {
+    REQUIRE(encode(level::high) == bytes({1}));
+    REQUIRE(*decode<level>(bytes({0})) == level::low);
+    REQUIRE(decode<level>(bytes({2})).error() == decode_error::invalid_value);
+    REQUIRE(encode(closed_error{}).empty());
+    REQUIRE(decode<closed_error>(bytes({})).has_value());
+    REQUIRE(decode<timeout_error>(encode(timeout_error{250}))->millis == 250);
+}
+
+TEST_CASE("serialize variant", "[serialize]") {
+    using var_t = variant<uint8_t, std::string, void>;
+    REQUIRE(encode(var_t{std::in_place_index<0>, uint8_t{9}}) == bytes({0, 9}));
+    REQUIRE(encode(var_t{std::in_place_index<1>, "hi"}) == bytes({1, 2, 'h', 'i'}));
+    REQUIRE(encode(var_t{std::in_place_index<2>}) == bytes({2}));
+
+    auto res = decode<var_t>(bytes({1, 2, 'h', 'i'}));
+    REQUIRE(res.has_value());
+    REQUIRE((*res)[index<1>] == "hi");
+    REQUIRE(decode<var_t>(bytes({2}))->index() == 2);
+    REQUIRE(decode<var_t>(bytes({3})).error() == decode_error::unknown_alternative);
+    REQUIRE(decode<var_t>(bytes({0})).error() == decode_error::unexpected_end);
+    REQUIRE(decode<var_t>(bytes({})).error() == decode_error::unexpected_end);
+    REQUIRE(decode<var_t>(bytes({0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+                                 0x80, 0x00}))
+                .error() == decode_error::invalid_varint);
+}
+
+TEST_CASE("serialize with stable ids", "[serialize]") {
+    using old_t = variant<timeout_error, refused_error>;
+    using new_t = variant<closed_error, refused_error, timeout_error>;
+    const auto buf1 = encode(old_t{std::in_place_index<0>, timeout_error{250}});
+    const auto buf2 = encode(old_t{std::in_place_index<1>, refused_error{8080}});
+    REQUIRE(buf2.size() == 1 + sizeof(refused_error));
+
+    auto res1 = decode<new_t>(buf1);
+    REQUIRE(res1.has_value());
+    REQUIRE(res1->index() == 2);
+    REQUIRE((*res1)[index<2>].millis == 250);
+    auto res2 = decode<new_t>(buf2);
+    REQUIRE(res2.has_value());
+    REQUIRE((*res2)[index<1>].port == 8080);
+
+    const auto buf3 = encode(new_t{std::in_place_index<0>});
+    REQUIRE(buf3 == bytes({0xac, 0x02}));
+    REQUIRE(decode<old_t>(buf3).error() == decode_error::unknown_alternative);
+
+    using set_t = error_set<refused_error, timeout_error>;
+    auto res3 = decode<set_t>(buf1);
+    REQUIRE(res3.has_value());
+    REQUIRE(res3->index() == 1);
+}
+
+TEST_CASE("serialize option and result", "[serialize]") {
+    REQUIRE(encode(option<int16_t>{}) == bytes({0}));
+    REQUIRE(*decode<option<int16_t>>(encode(option<int16_t>{int16_t{5}})) == int16_t{5});
+    REQUIRE(!decode<option<int16_t>>(bytes({0}))->has_value());
+    REQUIRE(decode<option<void>>(bytes({1}))->has_value());
+
+    using res_t = result<std::string, uint8_t>;
+    REQUIRE(encode(res_t{"ok"}) == bytes({0, 2, 'o', 'k'}));
+    REQUIRE(encode(res_t{in_place_error, uint8_t{4}}) == bytes({1, 4}));
+    REQUIRE(decode<res_t>(bytes({1, 4}))->error() == 4);
+    REQUIRE(decode<result<void, void>>(bytes({0}))->has_value());
+
+    using nested_t = option<result<variant<int, std::string>, std::string>>;
+    const nested_t nested{std::in_place, std::in_place, std::in_place_index<1>, "deep"};
+    auto res = decode<nested_t>(encode(nested));
+    REQUIRE(res.has_value());
+    REQUIRE(*res == nested);
+}
+
+TEST_CASE("deserialize constructs in place", "[serialize]") {
+    using var_t = variant<int, tracked>;
+    auto res = decode<var_t>(encode(var_t{std::in_place_index<1>, "alice"}));
+    REQUIRE(res.has_value());
+    REQUIRE((*res)[index<1>].name == "alice");
+    REQUIRE((*res)[index<1>].copies == 0);
+
+    auto opt = decode<option<tracked>>(encode(option<tracked>{std::in_place, "bob"}));
+    REQUIRE(opt.has_value());
+    REQUIRE((*opt)->name == "bob");
+    REQUIRE((*opt)->copies == 0);
+}
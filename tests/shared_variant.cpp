@@ -0,0 +1,106 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstddef>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "sumty/shared_variant.hpp" // IWYU pragma: associated
+#include "sumty/utils.hpp"
+#include "sumty/variant.hpp"
+
+using namespace sumty;
+
+TEST_CASE("shared_variant construct", "[shared_variant]") {
+    shared_variant<int, std::string> sv1{};
+    REQUIRE(sv1.index() == 0);
+    REQUIRE(get<0>(*sv1) == 0);
+    REQUIRE(sv1.use_count() == 1);
+    REQUIRE(sv1.unique());
+
+    shared_variant<int, std::string> sv2{variant<int, std::string>{std::string("hello")}};
+    REQUIRE(sv2.index() == 1);
+    REQUIRE(get<1>(sv2.get()) == "hello");
+
+    shared_variant<int, std::string> sv3{std::in_place_index<1>, 3, 'x'};
+    REQUIRE(sv3->index() == 1);
+    REQUIRE(get<1>(*sv3) == "xxx");
+}
+
+TEST_CASE("shared_variant copy shares storage", "[shared_variant]") {
+    shared_variant<int, std::vector<int>> sv1{std::in_place_index<1>, 1000, 7};
+    auto sv2 = sv1;
+    REQUIRE(sv1.use_count() == 2);
+    REQUIRE(!sv1.unique());
+    REQUIRE(&sv1.get() == &sv2.get());
+
+    shared_variant<int, std::vector<int>> sv3{};
+    sv3 = sv2;
+    REQUIRE(sv1.use_count() == 3);
+    REQUIRE(&sv3.get() == &sv1.get());
+
+    auto sv4 = std::move(sv3);
+    REQUIRE(sv1.use_count() == 3);
+    REQUIRE(sv3.use_count() == 0);
+    REQUIRE(&sv4.get() == &sv1.get());
+
+    sv3 = sv4;
+    REQUIRE(sv1.use_count() == 4);
+    sv3 = std::move(sv4);
+    REQUIRE(sv1.use_count() == 3);
+}
+
+TEST_CASE("shared_variant visit_mut copies on write", "[shared_variant]") {
+    shared_variant<int, std::vector<int>> sv1{std::in_place_index<1>, 3, 1};
+    auto sv2 = sv1;
+    const auto* shared = &sv1.get();
+
+    sv2.visit_mut(overload([](int& val) { ++val; }, [](std::vector<int>& vec) {
+        vec.push_back(2);
+    }));
+    REQUIRE(&sv2.get() != shared);
+    REQUIRE(&sv1.get() == shared);
+    REQUIRE(sv1.unique());
+    REQUIRE(sv2.unique());
+    REQUIRE(get<1>(*sv1).size() == 3);
+    REQUIRE(get<1>(*sv2).size() == 4);
+
+    const auto* owned = &sv2.get();
+    sv2.visit_mut(overload([](int& val) { ++val; }, [](std::vector<int>& vec) {
+        vec.push_back(3);
+    }));
+    REQUIRE(&sv2.get() == owned);
+    REQUIRE(get<1>(*sv2).size() == 5);
+}
+
+TEST_CASE("shared_variant make_mut", "[shared_variant]") {
+    shared_variant<int, std::string> sv1{};
+    auto sv2 = sv1;
+    sv2.make_mut().emplace<1>("world");
+    REQUIRE(sv1.index() == 0);
+    REQUIRE(sv2.index() == 1);
+    REQUIRE(get<1>(*sv2) == "world");
+}
+
+TEST_CASE("shared_variant visit", "[shared_variant]") {
+    const shared_variant<int, std::string> sv{std::in_place_index<1>, "abc"};
+    auto len = sv.visit(overload([](int) { return size_t{0}; },
+                                 [](const std::string& str) { return str.size(); }));
+    REQUIRE(len == 3);
+}
+
+TEST_CASE("shared_variant concurrent copies", "[shared_variant]") {
+    shared_variant<int, std::vector<int>> sv{std::in_place_index<1>, 100, 1};
+    std::vector<std::thread> threads{};
+    for (int i = 0; i < 4; ++i) {
+        threads.emplace_back([sv] {
+            for (int j = 0; j < 1000; ++j) {
+                auto copy = sv;
+                REQUIRE(get<1>(*copy).size() == 100);
+            }
+        });
+    }
+    for (auto& thread : threads) { thread.join(); }
+    REQUIRE(sv.unique());
+}
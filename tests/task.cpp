@@ -0,0 +1,166 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "sumty/result.hpp"
+#include "sumty/task.hpp" // IWYU pragma: associated
+
+using namespace sumty;
+
+namespace {
+
+task<int, std::string> answer() {
+    co_return 42;
+}
+
+task<int, std::string> fail(std::string msg) {
+    co_return error<std::string>(std::move(msg));
+}
+
+task<int, std::string> add(bool fail_first) {
+    auto first = fail_first ? fail("lhs") : answer();
+    int lhs = co_await co_await std::move(first);
+    int rhs = co_await co_await answer();
+    co_return lhs + rhs;
+}
+
+task<int, std::string> checked_div(int num, int den) {
+    const result<int, std::string> quot =
+        den == 0 ? result<int, std::string>(error<std::string>("divide by zero"))
+                 : result<int, std::string>(num / den);
+    int val = co_await quot;
+    co_return val + 1;
+}
+
+task<long, std::string> sum_to(long n) {
+    if (n == 0) { co_return 0L; }
+    long rest = co_await co_await sum_to(n - 1);
+    co_return rest + n;
+}
+
+task<void, int> no_value(bool ok) {
+    if (!ok) { co_return error<int>(7); }
+    co_return {};
+}
+
+task<int, std::string> throws() {
+    throw std::runtime_error("oops");
+    co_return 0;
+}
+
+task<int, std::string> catches() {
+    try {
+        static_cast<void>(co_await throws());
+    } catch (const std::runtime_error&) { co_return 1; }
+    co_return 0;
+}
+
+template <typename Ex>
+task<std::thread::id, std::string> hop(Ex& exec) {
+    co_await exec.schedule();
+    co_return std::this_thread::get_id();
+}
+
+template <typename T>
+concept awaitable_member = requires(T&& tsk) { std::forward<T>(tsk).operator co_await(); };
+
+} // namespace
+
+TEST_CASE("task co_return", "[task]") {
+    auto res = sync_wait(answer());
+    REQUIRE(res.has_value());
+    REQUIRE(*res == 42);
+
+    auto err = sync_wait(fail("bad"));
+    REQUIRE(!err.has_value());
+    REQUIRE(err.error() == "bad");
+}
+
+TEST_CASE("task awaited as rvalue", "[task]") {
+    STATIC_CHECK(awaitable_member<task<int, std::string>>);
+    STATIC_CHECK(!awaitable_member<task<int, std::string>&>);
+    STATIC_CHECK(!awaitable_member<const task<int, std::string>&>);
+}
+
+TEST_CASE("task error propagation", "[task]") {
+    REQUIRE(sync_wait(add(false)) == 84);
+    auto res = sync_wait(add(true));
+    REQUIRE(!res.has_value());
+    REQUIRE(res.error() == "lhs");
+
+    REQUIRE(sync_wait(checked_div(10, 2)) == 6);
+    auto div = sync_wait(checked_div(1, 0));
+    REQUIRE(!div.has_value());
+    REQUIRE(div.error() == "divide by zero");
+}
+
+TEST_CASE("task void", "[task]") {
+    REQUIRE(sync_wait(no_value(true)).has_value());
+    auto res = sync_wait(no_value(false));
+    REQUIRE(!res.has_value());
+    REQUIRE(res.error() == 7);
+}
+
+TEST_CASE("task symmetric transfer", "[task]") {
+    constexpr long depth = 10000;
+    REQUIRE(sync_wait(sum_to(depth)) == depth * (depth + 1) / 2);
+}
+
+TEST_CASE("task exception", "[task]") {
+    REQUIRE(sync_wait(catches()) == 1);
+}
+
+TEST_CASE("task single_thread_executor", "[task]") {
+    single_thread_executor loop{};
+    auto res = loop.block_on(hop(loop));
+    REQUIRE(res.has_value());
+    REQUIRE(*res == std::this_thread::get_id());
+
+    int count = 0;
+    auto counter = [](single_thread_executor& exec, int& cnt) -> task<int, std::string> {
+        for (int i = 0; i < 3; ++i) {
+            co_await exec.schedule();
+            ++cnt;
+        }
+        co_return cnt;
+    };
+    REQUIRE(loop.block_on(counter(loop, count)) == 3);
+    REQUIRE(loop.run() == 0);
+}
+
+TEST_CASE("task thread_pool_executor", "[task]") {
+    thread_pool_executor pool{2};
+    auto res = sync_wait(hop(pool));
+    REQUIRE(res.has_value());
+    REQUIRE(*res != std::this_thread::get_id());
+
+    single_thread_executor loop{};
+    auto back = [](thread_pool_executor& from,
+                   single_thread_executor& to) -> task<bool, std::string> {
+        co_await from.schedule();
+        co_await to.schedule();
+        co_return true;
+    };
+    REQUIRE(loop.block_on(back(pool, loop)) == true);
+}
+
+TEST_CASE("task concurrent", "[task]") {
+    thread_pool_executor pool{4};
+    std::atomic<int> total{0};
+    std::vector<std::thread> threads{};
+    for (int i = 0; i < 4; ++i) {
+        threads.emplace_back([&pool, &total] {
+            for (int j = 0; j < 100; ++j) {
+                auto res = sync_wait(hop(pool));
+                if (res.has_value()) { ++total; }
+            }
+        });
+    }
+    for (auto& thread : threads) { thread.join(); }
+    REQUIRE(total == 400);
+}
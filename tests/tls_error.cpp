@@ -0,0 +1,122 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <latch>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "sumty/result.hpp"
+#include "sumty/tls_error.hpp" // IWYU pragma: associated
+
+using namespace sumty;
+
+namespace {
+
+struct big_error {
+    std::array<char, 256> data{};
+    int code = 0;
+};
+
+result<int, tls_error<big_error>> fallible(bool fail, int code) {
+    if (fail) { return error<big_error>(big_error{{}, code}); }
+    return code;
+}
+
+} // namespace
+
+TEST_CASE("tls_error result size", "[tls_error]") {
+    STATIC_CHECK(sizeof(tls_error<big_error>) == sizeof(uint32_t));
+    STATIC_CHECK(sizeof(result<int, tls_error<big_error>>) ==
+                 sizeof(result<int, uint32_t>));
+    STATIC_CHECK(std::is_trivially_copyable_v<tls_error<big_error>>);
+}
+
+TEST_CASE("tls_error access", "[tls_error]") {
+    auto res1 = fallible(false, 1);
+    REQUIRE(res1.has_value());
+    REQUIRE(*res1 == 1);
+
+    auto res2 = fallible(true, 2);
+    REQUIRE(!res2.has_value());
+    REQUIRE(res2.error().valid());
+    REQUIRE(res2.error()->code == 2);
+    REQUIRE((*res2.error()).code == 2);
+    REQUIRE(res2.error().get().value().code == 2);
+
+    tls_error<std::string, 2> err{std::in_place, 3, 'x'};
+    REQUIRE(*err == "xxx");
+}
+
+TEST_CASE("tls_error slot reuse", "[tls_error]") {
+    tls_error<int, 2> err1 = 1;
+    tls_error<int, 2> err2 = 2;
+    REQUIRE(err1.valid());
+    REQUIRE(err2.valid());
+    tls_error<int, 2> err3 = 3;
+    REQUIRE(!err1.valid());
+    REQUIRE(!err1.get().has_value());
+    REQUIRE(*err2 == 2);
+    REQUIRE(*err3 == 3);
+}
+
+TEST_CASE("tls_error thread local", "[tls_error]") {
+    tls_error<int, 4> err = 42;
+    int other = 0;
+    std::thread thread([&other] {
+        tls_error<int, 4> local = 7;
+        other = *local;
+    });
+    thread.join();
+    REQUIRE(other == 7);
+    REQUIRE(err.valid());
+    REQUIRE(*err == 42);
+}
+
+TEST_CASE("tls_error foreign thread", "[tls_error]") {
+    tls_error<int, 4> err = 42;
+    bool filled = true;
+    bool valid = true;
+    bool has_value = true;
+    std::thread thread([&] {
+        // fill every slot of this thread's ring
+        for (int i = 0; i < 4; ++i) {
+            tls_error<int, 4> local = i;
+            filled = filled && local.valid();
+        }
+        valid = err.valid();
+        has_value = err.get().has_value();
+    });
+    thread.join();
+    REQUIRE(filled);
+    REQUIRE(!valid);
+    REQUIRE(!has_value);
+    REQUIRE(err.valid());
+    REQUIRE(*err == 42);
+}
+
+TEST_CASE("tls_error concurrent threads", "[tls_error]") {
+    constexpr int count = 1000;
+    std::latch start{2};
+    auto run = [&start](int base, bool& ok) {
+        std::vector<tls_error<int, 2>> errs{};
+        errs.reserve(count);
+        start.arrive_and_wait();
+        for (int i = 0; i < count; ++i) { errs.emplace_back(base + i); }
+        // the last two errors created on this thread are still stored
+        ok = errs[count - 1].valid() && *errs[count - 1] == base + count - 1 &&
+             errs[count - 2].valid() && *errs[count - 2] == base + count - 2 &&
+             !errs[count - 3].valid();
+    };
+    bool ok1 = false;
+    bool ok2 = false;
+    std::thread thread1(run, 0, std::ref(ok1));
+    std::thread thread2(run, count, std::ref(ok2));
+    thread1.join();
+    thread2.join();
+    REQUIRE(ok1);
+    REQUIRE(ok2);
+}
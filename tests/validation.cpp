@@ -0,0 +1,152 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "sumty/error_set.hpp"
+#include "sumty/result.hpp"
+#include "sumty/validation.hpp" // IWYU pragma: associated
+
+using namespace sumty;
+
+TEST_CASE("error_list inline storage", "[validation]") {
+    error_list<std::string, 2> errs;
+    REQUIRE(errs.empty());
+    REQUIRE(errs.is_inline());
+    errs.push_back("first");
+    errs.emplace_back("second");
+    REQUIRE(errs.size() == 2);
+    REQUIRE(errs.is_inline());
+    REQUIRE(errs.front() == "first");
+    REQUIRE(errs.back() == "second");
+    errs.push_back(errs.front());
+    REQUIRE(!errs.is_inline());
+    REQUIRE(errs.size() == 3);
+    REQUIRE(errs[2] == "first");
+    auto moved = std::move(errs);
+    REQUIRE(moved.size() == 3);
+    REQUIRE(!moved.is_inline());
+    auto copied = moved;
+    REQUIRE(copied.size() == 3);
+    REQUIRE(copied[1] == "second");
+}
+
+namespace {
+
+struct fragile {
+    static inline int live = 0;
+    static inline int copies_left = -1;
+
+    int id;
+
+    explicit fragile(int val) : id(val) { ++live; }
+
+    fragile(const fragile& other) : id(other.id) {
+        if (copies_left == 0) { throw std::runtime_error("copy failed"); }
+        if (copies_left > 0) { --copies_left; }
+        ++live;
+    }
+
+    // NOLINTNEXTLINE(performance-noexcept-move-constructor)
+    fragile(fragile&& other) : fragile(std::as_const(other)) {}
+
+    fragile& operator=(const fragile&) = delete;
+    fragile& operator=(fragile&&) = delete;
+
+    ~fragile() noexcept { --live; }
+};
+
+} // namespace
+
+TEST_CASE("error_list growth is exception safe", "[validation]") {
+    {
+        error_list<fragile, 2> errs;
+        errs.emplace_back(1);
+        errs.emplace_back(2);
+        fragile::copies_left = 1;
+        REQUIRE_THROWS_AS(errs.emplace_back(3), std::runtime_error);
+        fragile::copies_left = -1;
+        REQUIRE(errs.size() == 2);
+        REQUIRE(errs.is_inline());
+        REQUIRE(errs[0].id == 1);
+        REQUIRE(errs[1].id == 2);
+        REQUIRE(fragile::live == 2);
+        errs.emplace_back(3);
+        REQUIRE(!errs.is_inline());
+        REQUIRE(errs[2].id == 3);
+    }
+    REQUIRE(fragile::live == 0);
+}
+
+TEST_CASE("validation construct", "[validation]") {
+    validation<int, std::string> v1 = 42;
+    REQUIRE(v1.has_value());
+    REQUIRE(*v1 == 42);
+    REQUIRE(v1.value() == 42);
+    REQUIRE(v1.error_count() == 0);
+    validation<int, std::string> v2 = error<std::string>("bad");
+    REQUIRE(!v2.has_value());
+    REQUIRE(v2.error_count() == 1);
+    REQUIRE(v2.errors()[0] == "bad");
+    validation<int, std::string> v3{in_place_error, 3, 'x'};
+    REQUIRE(v3.errors()[0] == "xxx");
+    validation<void, std::string> v4{};
+    REQUIRE(v4.has_value());
+}
+
+TEST_CASE("validation combine", "[validation]") {
+    validation<int, std::string> v1 = error<std::string>("bad int");
+    validation<bool, std::string> v2 = true;
+    validation<float, std::string> v3 = error<std::string>("bad float");
+    validation<void, std::string> v4{};
+
+    auto all = combine(v1, v2, v3, v4);
+    STATIC_CHECK(
+        std::is_same_v<decltype(all),
+                       validation<std::tuple<int, bool, float, void_t>, std::string>>);
+    REQUIRE(!all.has_value());
+    REQUIRE(all.errors().size() == 2);
+    REQUIRE(all.errors()[0] == "bad int");
+    REQUIRE(all.errors()[1] == "bad float");
+    REQUIRE(all.errors().is_inline());
+
+    auto ok = combine(validation<int, std::string>{1}, v2, v4);
+    REQUIRE(ok.has_value());
+    REQUIRE(std::get<0>(*ok) == 1);
+    REQUIRE(std::get<1>(*ok) == true);
+}
+
+TEST_CASE("validation to result", "[validation]") {
+    validation<int, std::string> v1 = 42;
+    REQUIRE(v1.ok_or_first_error() == 42);
+    validation<int, std::string> v2 = error<std::string>("first");
+    v2.emplace_error("second");
+    auto res1 = v2.ok_or_errors();
+    REQUIRE(!res1.has_value());
+    REQUIRE(res1.error().size() == 2);
+    auto res2 = std::move(v2).ok_or_first_error();
+    REQUIRE(!res2.has_value());
+    REQUIRE(res2.error() == "first");
+
+    validation<int, error_set<int, std::string>> v3{in_place_error, std::string("bad")};
+    result<int, error_set<int, std::string>> res3 = v3.ok_or_first_error();
+    REQUIRE(!res3.has_value());
+    REQUIRE(holds_alternative<std::string>(res3.error()));
+    REQUIRE(get<1>(res3.error()) == "bad");
+
+    validation<int, std::string> v4 = result<int, std::string>{in_place_error, "bad"};
+    REQUIRE(v4.errors()[0] == "bad");
+}
+
+TEST_CASE("validation transform", "[validation]") {
+    validation<int, std::string> v1 = 21;
+    auto v2 = v1.transform([](int x) { return x * 2; });
+    REQUIRE(*v2 == 42);
+    validation<int, std::string> v3 = error<std::string>("bad");
+    auto v4 = std::move(v3).transform([](int x) { return x * 2; });
+    REQUIRE(!v4.has_value());
+    REQUIRE(v4.errors()[0] == "bad");
+}
@@ -1,5 +1,15 @@
+#include <algorithm>
 #include <catch2/catch_test_macros.hpp>
+#include <compare>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <string_view>
 #include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
 #include <vector>
 
 #include "sumty/variant.hpp"
@@ -36,6 +46,20 @@ TEST_CASE("special variant sizes", "[variant]") {
                  max(sizeof(int), sizeof(float), sizeof(char), sizeof(bool)) * 2);
 }
 
+TEST_CASE("trivially copyable variant", "[variant]") {
+    STATIC_CHECK(std::is_trivially_copyable_v<variant<int>>);
+    STATIC_CHECK(std::is_trivially_copyable_v<variant<int, float, char>>);
+    STATIC_CHECK(std::is_trivially_copyable_v<variant<void, int, int&>>);
+    STATIC_CHECK(!std::is_trivially_copyable_v<variant<int, std::vector<int>>>);
+    variant<int, float> v1{std::in_place_index<1>, 1.5F};
+    variant<int, float> v2 = v1;
+    REQUIRE(v2.index() == 1);
+    REQUIRE(v2[index<1>] == 1.5F);
+    v2 = variant<int, float>{std::in_place_index<0>, 42};
+    REQUIRE(v2.index() == 0);
+    REQUIRE(v2[index<0>] == 42);
+}
+
 TEST_CASE("variant default construct", "[variant]") {
     variant<int, float&, void> v;
     REQUIRE(v.index() == 0);
@@ -382,11 +406,167 @@ TEST_CASE("variant swap", "[variant]") {
     REQUIRE(get<2>(v2) == INIT_FLT_2);
 }
 
+TEST_CASE("variant checked get", "[variant]") {
+    static constexpr int INIT_VAL = 42;
+    variant<int, float, void> v{std::in_place_index<0>, INIT_VAL};
+    REQUIRE(v.get<0>() == INIT_VAL);
+    REQUIRE(std::as_const(v).get<0>() == INIT_VAL);
+    REQUIRE_THROWS_AS(v.get<1>(), bad_variant_access);
+    REQUIRE_THROWS_AS(std::as_const(v).get<1>(), bad_variant_access);
+    REQUIRE_THROWS_AS(std::move(v).get<2>(), bad_variant_access);
+    REQUIRE_THROWS_AS(get<float>(v), bad_variant_access);
+}
+
+TEST_CASE("variant equality", "[variant]") {
+    using var_t = variant<int, std::string, void>;
+    const var_t v1{std::in_place_index<0>, 42};
+    const var_t v2{std::in_place_index<0>, 24};
+    const var_t v3{std::in_place_index<1>, "42"};
+    const var_t v4{std::in_place_index<2>};
+    REQUIRE(v1 == v1);
+    REQUIRE(v1 != v2);
+    REQUIRE(v1 != v3);
+    REQUIRE(v4 == var_t{std::in_place_index<2>});
+    REQUIRE(v4 != v1);
+
+    REQUIRE(v1 == 42);
+    REQUIRE(42 == v1);
+    REQUIRE(v1 != 24);
+    REQUIRE(v3 == std::string_view{"42"});
+    REQUIRE(v3 != 42);
+    REQUIRE(v4 != 42);
+}
+
+TEST_CASE("variant bytewise equality", "[variant]") {
+    enum class color : int { red, green };
+    using same_size_t = variant<int, unsigned, color>;
+    constexpr auto i0 = std::in_place_index<0>;
+    constexpr auto i1 = std::in_place_index<1>;
+    constexpr auto i2 = std::in_place_index<2>;
+    REQUIRE(same_size_t{i0, 1} == same_size_t{i0, 1});
+    REQUIRE(same_size_t{i0, 1} != same_size_t{i0, 2});
+    REQUIRE(same_size_t{i0, 1} != same_size_t{i1, 1U});
+    REQUIRE(same_size_t{i2, color::green} == same_size_t{i2, color::green});
+
+    using mixed_size_t = variant<char, long long, int*>;
+    int value = 0;
+    mixed_size_t v1{i1, 0x1234LL};
+    mixed_size_t v2{i0, 'a'};
+    v1 = mixed_size_t{i0, 'a'};
+    REQUIRE(v1 == v2);
+    REQUIRE(v1 != mixed_size_t{i0, 'b'});
+    REQUIRE(mixed_size_t{i2, &value} == mixed_size_t{i2, &value});
+
+}
+
+TEST_CASE("variant ordering", "[variant]") {
+    using var_t = variant<int, std::string, void>;
+    const var_t v1{std::in_place_index<0>, 42};
+    const var_t v2{std::in_place_index<0>, 24};
+    const var_t v3{std::in_place_index<1>, "a"};
+    const var_t v4{std::in_place_index<2>};
+    STATIC_CHECK(std::is_same_v<decltype(v1 <=> v2), std::strong_ordering>);
+    REQUIRE((v1 <=> v2) == std::strong_ordering::greater);
+    REQUIRE((v2 <=> v1) == std::strong_ordering::less);
+    REQUIRE((v1 <=> v1) == std::strong_ordering::equal);
+    REQUIRE(v1 < v3);
+    REQUIRE(v3 < v4);
+    REQUIRE((v4 <=> var_t{std::in_place_index<2>}) == std::strong_ordering::equal);
+
+    STATIC_CHECK(std::is_same_v<decltype(variant<int, double>{} <=> variant<int, double>{}),
+                                std::partial_ordering>);
+    STATIC_CHECK(!std::three_way_comparable<variant<int, empty_t>>);
+
+    std::vector<var_t> values{v4, v3, v1, v2, v3, v1};
+    std::sort(values.begin(), values.end());
+    values.erase(std::unique(values.begin(), values.end()), values.end());
+    REQUIRE(values == std::vector<var_t>{v2, v1, v3, v4});
+}
+
+namespace {
+
+struct pod_key {
+    int a;
+    int b;
+
+    friend bool operator==(const pod_key&, const pod_key&) = default;
+};
+
+template <typename L, typename R>
+concept equality_comparable_to = requires(const L& lhs, const R& rhs) {
+    { lhs == rhs } -> std::convertible_to<bool>;
+};
+
+} // namespace
+
+TEST_CASE("variant compare with value", "[variant]") {
+    using var_t = variant<int, std::string>;
+    REQUIRE(var_t{std::in_place_index<1>, "hello"} == std::string_view{"hello"});
+    REQUIRE(var_t{std::in_place_index<1>, "hello"} != 42);
+    REQUIRE(42 != var_t{std::in_place_index<1>, "hello"});
+    STATIC_CHECK(equality_comparable_to<var_t, double>);
+    STATIC_CHECK(!equality_comparable_to<variant<std::string>, double>);
+    STATIC_CHECK(!equality_comparable_to<double, variant<std::string>>);
+    STATIC_CHECK(!equality_comparable_to<variant<std::string, void>, pod_key>);
+}
+
+TEST_CASE("variant hash", "[variant]") {
+    using var_t = variant<int, long, std::string, void>;
+    const std::hash<var_t> hasher{};
+    REQUIRE(hasher(var_t{std::in_place_index<0>, 1}) ==
+            hasher(var_t{std::in_place_index<0>, 1}));
+    REQUIRE(hasher(var_t{std::in_place_index<0>, 1}) !=
+            hasher(var_t{std::in_place_index<1>, 1}));
+    REQUIRE(hasher(var_t{std::in_place_index<3>}) == hasher(var_t{std::in_place_index<3>}));
+
+    STATIC_CHECK(std::is_default_constructible_v<std::hash<variant<int, pod_key>>>);
+    STATIC_CHECK(
+        !std::is_default_constructible_v<std::hash<variant<int, std::vector<int>>>>);
+    const std::hash<variant<int, pod_key>> pod_hasher{};
+    REQUIRE(pod_hasher(variant<int, pod_key>{std::in_place_index<1>, 1, 2}) ==
+            pod_hasher(variant<int, pod_key>{std::in_place_index<1>, 1, 2}));
+
+    int value = 42;
+    const variant<int&, void> ref{std::in_place_index<0>, value};
+    const variant<int, void> val{std::in_place_index<0>, 42};
+    REQUIRE(std::hash<variant<int&, void>>{}(ref) == std::hash<variant<int, void>>{}(val));
+}
+
+TEST_CASE("variant unordered containers", "[variant]") {
+    using map_key_t = variant<int, std::string>;
+    std::unordered_set<map_key_t> set{};
+    set.emplace(std::in_place_index<0>, 1);
+    set.emplace(std::in_place_index<1>, "one");
+    set.emplace(std::in_place_index<0>, 1);
+    REQUIRE(set.size() == 2);
+    REQUIRE(set.contains(map_key_t{std::in_place_index<1>, "one"}));
+
+    std::unordered_map<map_key_t, int, std::hash<map_key_t>, std::equal_to<>> map{};
+    map.emplace(map_key_t{std::in_place_index<0>, 1}, 10);
+    map.emplace(map_key_t{std::in_place_index<1>, "one"}, 11);
+    REQUIRE(map.find(std::string_view{"one"}) != map.end());
+    REQUIRE(map.find(std::string_view{"one"})->second == 11);
+    REQUIRE(map.find(std::string_view{"two"}) == map.end());
+    REQUIRE(map.find(1)->second == 10);
+    REQUIRE(map.contains("one"));
+
+    // 5.0 compares equal to the int alternative, but does not hash like it,
+    // so it must go through the variant hash instead of the key hash
+    std::unordered_set<map_key_t, std::hash<map_key_t>, std::equal_to<>> keys{};
+    keys.emplace(std::in_place_index<0>, 5);
+    REQUIRE(map_key_t{std::in_place_index<0>, 5} == 5.0);
+    REQUIRE(std::hash<map_key_t>{}(5.0) == std::hash<map_key_t>{}(map_key_t{5}));
+    REQUIRE(keys.find(5.0) != keys.end());
+    REQUIRE(keys.contains(5.0));
+    REQUIRE(!keys.contains(6.0));
+}
+
 // XXX: The below headers are included to make sure they get checked
 //      by include-what-you-use.
 
 #include "sumty/detail/auto_union.hpp"   // IWYU pragma: associated
 #include "sumty/detail/fwd.hpp"          // IWYU pragma: associated
+#include "sumty/detail/hash.hpp"         // IWYU pragma: associated
 #include "sumty/detail/traits.hpp"       // IWYU pragma: associated
 #include "sumty/detail/utils.hpp"        // IWYU pragma: associated
 #include "sumty/detail/variant_impl.hpp" // IWYU pragma: associated